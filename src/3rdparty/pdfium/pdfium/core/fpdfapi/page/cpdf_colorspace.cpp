@@ -228,7 +228,6 @@ class CPDF_ICCBasedCS final : public CPDF_ColorSpace {
 
   RetainPtr<CPDF_ColorSpace> m_pAlterCS;
   RetainPtr<CPDF_IccProfile> m_pProfile;
-  mutable std::vector<uint8_t, FxAllocAllocator<uint8_t>> m_pCache;
   std::vector<float> m_pRanges;
 };
 
@@ -989,55 +988,27 @@ void CPDF_ICCBasedCS::TranslateImageLine(uint8_t* pDestBuf,
     return;
   }
 
-  // |nMaxColors| will not overflow since |nComponents| is limited in size.
+  // 1-component input goes through an exact 256-entry table. For larger
+  // 3-component images, a quantized table is cheaper than the transform.
   const uint32_t nComponents = CountComponents();
   ASSERT(IsValidIccComponents(nComponents));
-  int nMaxColors = 1;
-  for (uint32_t i = 0; i < nComponents; i++)
-    nMaxColors *= 52;
-
-  bool bTranslate = nComponents > 3;
-  if (!bTranslate) {
+  bool bTranslate = nComponents > 3 || m_pProfile->transform()->IsLab();
+  if (!bTranslate && nComponents == 3) {
+    constexpr int kLevels = IccModule::kLookupLevels;
     FX_SAFE_INT32 nPixelCount = image_width;
     nPixelCount *= image_height;
-    if (nPixelCount.IsValid())
-      bTranslate = nPixelCount.ValueOrDie() < nMaxColors * 3 / 2;
+    if (nPixelCount.IsValid()) {
+      bTranslate =
+          nPixelCount.ValueOrDie() < kLevels * kLevels * kLevels * 3 / 2;
+    }
   }
   if (bTranslate) {
     IccModule::TranslateScanline(m_pProfile->transform(), pDestBuf, pSrcBuf,
                                  pixels);
     return;
   }
-
-  if (m_pCache.empty()) {
-    m_pCache =
-        pdfium::Vector2D<uint8_t, FxAllocAllocator<uint8_t>>(nMaxColors, 3);
-    auto temp_src = pdfium::Vector2D<uint8_t, FxAllocAllocator<uint8_t>>(
-        nMaxColors, nComponents);
-    size_t src_index = 0;
-    for (int i = 0; i < nMaxColors; i++) {
-      uint32_t color = i;
-      uint32_t order = nMaxColors / 52;
-      for (uint32_t c = 0; c < nComponents; c++) {
-        temp_src[src_index++] = static_cast<uint8_t>(color / order * 5);
-        color %= order;
-        order /= 52;
-      }
-    }
-    IccModule::TranslateScanline(m_pProfile->transform(), m_pCache.data(),
-                                 temp_src.data(), nMaxColors);
-  }
-  for (int i = 0; i < pixels; i++) {
-    int index = 0;
-    for (uint32_t c = 0; c < nComponents; c++) {
-      index = index * 52 + (*pSrcBuf) / 5;
-      pSrcBuf++;
-    }
-    index *= 3;
-    *pDestBuf++ = m_pCache[index];
-    *pDestBuf++ = m_pCache[index + 1];
-    *pDestBuf++ = m_pCache[index + 2];
-  }
+  IccModule::TranslateScanlineWithLookupTable(m_pProfile->transform(),
+                                              pDestBuf, pSrcBuf, pixels);
 }
 
 bool CPDF_ICCBasedCS::IsNormal() const {
@@ -169,11 +169,14 @@ CPDF_ContentParser::Stage CPDF_ContentParser::PrepareContent() {
   m_pData.Reset(
       std::unique_ptr<uint8_t, FxFreeDeleter>(FX_Alloc(uint8_t, m_Size)));
 
+  // Release each decoded stream as soon as it is copied, so the page's content
+  // is not held twice while the combined buffer fills up.
   uint32_t pos = 0;
-  for (const auto& stream : m_StreamArray) {
+  for (auto& stream : m_StreamArray) {
     memcpy(m_pData.Get() + pos, stream->GetData(), stream->GetSize());
     pos += stream->GetSize();
     m_pData.Get()[pos++] = ' ';
+    stream.Reset();
   }
   m_StreamArray.clear();
 
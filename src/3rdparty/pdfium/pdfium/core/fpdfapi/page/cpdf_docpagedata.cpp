@@ -36,11 +36,18 @@
 #include "core/fxge/cfx_fontmapper.h"
 #include "core/fxge/cfx_substfont.h"
 #include "core/fxge/cfx_unicodeencoding.h"
+#include "core/fxge/dib/cfx_dibitmap.h"
 #include "core/fxge/fx_font.h"
 #include "base/stl_util.h"
 
 namespace {
 
+constexpr size_t kMaxTilingCellBytes = 32 * 1024 * 1024;
+
+size_t GetTilingCellSize(const RetainPtr<CFX_DIBitmap>& pCell) {
+  return pCell->GetPitch() * pCell->GetHeight();
+}
+
 void InsertWidthArrayImpl(std::vector<int> widths, CPDF_Array* pWidthArray) {
   size_t i;
   for (i = 1; i < widths.size(); i++) {
@@ -357,6 +364,74 @@ RetainPtr<CPDF_Pattern> CPDF_DocPageData::GetPattern(CPDF_Object* pPatternObj,
   return pPattern;
 }
 
+RetainPtr<CFX_DIBitmap> CPDF_DocPageData::GetTilingCell(
+    CPDF_TilingPattern* pPattern,
+    const ByteString& key) {
+  auto* cells = pPattern->cached_cells();
+  auto it = cells->find(key);
+  if (it == cells->end())
+    return nullptr;
+
+  it->second.last_use = ++m_TilingCellUseCount;
+  return it->second.bitmap;
+}
+
+void CPDF_DocPageData::CacheTilingCell(CPDF_TilingPattern* pPattern,
+                                       const ByteString& key,
+                                       const RetainPtr<CFX_DIBitmap>& pCell) {
+  const size_t size = GetTilingCellSize(pCell);
+  if (size > kMaxTilingCellBytes)
+    return;
+
+  auto* cells = pPattern->cached_cells();
+  auto it = cells->find(key);
+  if (it != cells->end()) {
+    m_TilingCellBytes -= GetTilingCellSize(it->second.bitmap);
+    cells->erase(it);
+  }
+  if (m_TilingCellBytes + size > kMaxTilingCellBytes)
+    EvictTilingCells(size);
+
+  CPDF_TilingPattern::CachedCell& cell = (*cells)[key];
+  cell.bitmap = pCell;
+  cell.last_use = ++m_TilingCellUseCount;
+  m_TilingCellBytes += size;
+}
+
+void CPDF_DocPageData::EvictTilingCells(size_t new_bytes) {
+  struct CellInfo {
+    uint64_t last_use;
+    CPDF_TilingPattern* pattern;
+    ByteString key;
+    size_t size;
+  };
+  std::vector<CellInfo> cell_info;
+  m_TilingCellBytes = 0;
+  for (auto& it : m_PatternMap) {
+    CPDF_TilingPattern* pPattern =
+        it.second ? it.second->AsTilingPattern() : nullptr;
+    if (!pPattern)
+      continue;
+
+    for (const auto& cell : *pPattern->cached_cells()) {
+      const size_t size = GetTilingCellSize(cell.second.bitmap);
+      cell_info.push_back({cell.second.last_use, pPattern, cell.first, size});
+      m_TilingCellBytes += size;
+    }
+  }
+  std::sort(cell_info.begin(), cell_info.end(),
+            [](const CellInfo& a, const CellInfo& b) {
+              return a.last_use < b.last_use;
+            });
+  for (const CellInfo& info : cell_info) {
+    if (m_TilingCellBytes + new_bytes <= kMaxTilingCellBytes)
+      break;
+
+    info.pattern->cached_cells()->erase(info.key);
+    m_TilingCellBytes -= info.size;
+  }
+}
+
 RetainPtr<CPDF_Image> CPDF_DocPageData::GetImage(uint32_t dwStreamObjNum) {
   ASSERT(dwStreamObjNum);
   auto it = m_ImageMap.find(dwStreamObjNum);
@@ -394,8 +469,8 @@ RetainPtr<CPDF_IccProfile> CPDF_DocPageData::GetIccProfile(
     if (it_copied_stream != m_IccProfileMap.end() && it_copied_stream->second)
       return pdfium::WrapRetain(it_copied_stream->second.Get());
   }
-  auto pProfile =
-      pdfium::MakeRetain<CPDF_IccProfile>(pProfileStream, pAccessor->GetSpan());
+  auto pProfile = pdfium::MakeRetain<CPDF_IccProfile>(
+      pProfileStream, pAccessor->GetSpan(), bsDigest);
   m_IccProfileMap[pProfileStream].Reset(pProfile.Get());
   m_HashProfileMap[bsDigest].Reset(pProfileStream);
   return pProfile;
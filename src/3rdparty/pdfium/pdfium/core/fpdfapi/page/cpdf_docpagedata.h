@@ -19,6 +19,7 @@
 #include "core/fxcrt/observed_ptr.h"
 #include "core/fxcrt/retain_ptr.h"
 
+class CFX_DIBitmap;
 class CFX_Font;
 class CPDF_Dictionary;
 class CPDF_FontEncoding;
@@ -28,6 +29,7 @@ class CPDF_Object;
 class CPDF_Pattern;
 class CPDF_Stream;
 class CPDF_StreamAcc;
+class CPDF_TilingPattern;
 
 class CPDF_DocPageData : public CPDF_Document::PageDataIface,
                          public CPDF_Font::FormFactoryIface {
@@ -77,6 +79,15 @@ class CPDF_DocPageData : public CPDF_Document::PageDataIface,
                                      bool bShading,
                                      const CFX_Matrix& matrix);
 
+  // Rendered tiling pattern cells are stored on their patterns, but all
+  // cells in the document share one budget. Storing a cell evicts the least
+  // recently used cells of any pattern until it fits.
+  RetainPtr<CFX_DIBitmap> GetTilingCell(CPDF_TilingPattern* pPattern,
+                                        const ByteString& key);
+  void CacheTilingCell(CPDF_TilingPattern* pPattern,
+                       const ByteString& key,
+                       const RetainPtr<CFX_DIBitmap>& pCell);
+
   RetainPtr<CPDF_Image> GetImage(uint32_t dwStreamObjNum);
   void MaybePurgeImage(uint32_t dwStreamObjNum);
 
@@ -102,8 +113,16 @@ class CPDF_DocPageData : public CPDF_Document::PageDataIface,
       std::function<void(wchar_t, wchar_t, CPDF_Array*)> Insert);
   void Clear(bool bForceRelease);
 
+  // Recounts the cells of the live tiling patterns, then evicts the least
+  // recently used ones until |new_bytes| more fit in the budget.
+  void EvictTilingCells(size_t new_bytes);
+
   bool m_bForceClear = false;
 
+  // May overcount the cells of patterns destroyed since the last eviction.
+  size_t m_TilingCellBytes = 0;
+  uint64_t m_TilingCellUseCount = 0;
+
   // Specific destruction order may be required between maps.
   std::map<ByteString, RetainPtr<const CPDF_Stream>> m_HashProfileMap;
   std::map<const CPDF_Object*, ObservedPtr<CPDF_ColorSpace>> m_ColorSpaceMap;
@@ -6,6 +6,7 @@
 
 #include "core/fpdfapi/page/cpdf_iccprofile.h"
 
+#include "core/fpdfapi/page/cpdf_pagemodule.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
 #include "core/fxcodec/icc/iccmodule.h"
 
@@ -19,14 +20,15 @@ bool DetectSRGB(pdfium::span<const uint8_t> span) {
 }  // namespace
 
 CPDF_IccProfile::CPDF_IccProfile(const CPDF_Stream* pStream,
-                                 pdfium::span<const uint8_t> span)
+                                 pdfium::span<const uint8_t> span,
+                                 const ByteString& digest)
     : m_bsRGB(DetectSRGB(span)), m_pStream(pStream) {
   if (m_bsRGB) {
     m_nSrcComponents = 3;
     return;
   }
 
-  m_Transform = IccModule::CreateTransformSRGB(span);
+  m_Transform = CPDF_PageModule::GetInstance()->GetIccTransform(digest, span);
   if (m_Transform)
     m_nSrcComponents = m_Transform->components();
 }
@@ -10,6 +10,7 @@
 #include <cstdint>
 #include <memory>
 
+#include "core/fxcrt/bytestring.h"
 #include "core/fxcrt/observed_ptr.h"
 #include "core/fxcrt/retain_ptr.h"
 #include "base/span.h"
@@ -28,17 +29,20 @@ class CPDF_IccProfile final : public Retainable, public Observable {
   bool IsValid() const { return IsSRGB() || IsSupported(); }
   bool IsSRGB() const { return m_bsRGB; }
   bool IsSupported() const { return !!m_Transform; }
-  fxcodec::CLcmsCmm* transform() { return m_Transform.get(); }
+  fxcodec::CLcmsCmm* transform() { return m_Transform.Get(); }
   uint32_t GetComponents() const { return m_nSrcComponents; }
 
  private:
-  CPDF_IccProfile(const CPDF_Stream* pStream, pdfium::span<const uint8_t> span);
+  // |digest| is the SHA-1 of |span|, used to share the transform.
+  CPDF_IccProfile(const CPDF_Stream* pStream,
+                  pdfium::span<const uint8_t> span,
+                  const ByteString& digest);
   ~CPDF_IccProfile() override;
 
   const bool m_bsRGB;
   uint32_t m_nSrcComponents = 0;
   RetainPtr<const CPDF_Stream> const m_pStream;
-  std::unique_ptr<fxcodec::CLcmsCmm> m_Transform;
+  RetainPtr<fxcodec::CLcmsCmm> m_Transform;
 };
 
 #endif  // CORE_FPDFAPI_PAGE_CPDF_ICCPROFILE_H_
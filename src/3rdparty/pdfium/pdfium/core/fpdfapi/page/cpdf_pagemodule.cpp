@@ -10,9 +10,14 @@
 #include "core/fpdfapi/page/cpdf_colorspace.h"
 #include "core/fpdfapi/page/cpdf_devicecs.h"
 #include "core/fpdfapi/page/cpdf_patterncs.h"
+#include "core/fxcodec/icc/iccmodule.h"
 
 namespace {
 
+// Transforms kept alive with no document using them, so reopening a document
+// or opening a related one does not rebuild them.
+constexpr size_t kMaxIccTransforms = 16;
+
 CPDF_PageModule* g_PageModule = nullptr;
 
 }  // namespace
@@ -65,3 +70,25 @@ RetainPtr<CPDF_ColorSpace> CPDF_PageModule::GetStockCS(int family) {
 void CPDF_PageModule::ClearStockFont(CPDF_Document* pDoc) {
   CPDF_FontGlobals::GetInstance()->Clear(pDoc);
 }
+
+RetainPtr<CLcmsCmm> CPDF_PageModule::GetIccTransform(
+    const ByteString& digest,
+    pdfium::span<const uint8_t> span) {
+  auto it = m_IccTransformMap.find(digest);
+  if (it != m_IccTransformMap.end())
+    return it->second;
+
+  if (m_IccTransformMap.size() >= kMaxIccTransforms) {
+    for (auto purge_it = m_IccTransformMap.begin();
+         purge_it != m_IccTransformMap.end();) {
+      if (!purge_it->second || purge_it->second->HasOneRef())
+        purge_it = m_IccTransformMap.erase(purge_it);
+      else
+        ++purge_it;
+    }
+  }
+  RetainPtr<CLcmsCmm> transform = IccModule::CreateTransformSRGB(span);
+  if (m_IccTransformMap.size() < kMaxIccTransforms)
+    m_IccTransformMap[digest] = transform;
+  return transform;
+}
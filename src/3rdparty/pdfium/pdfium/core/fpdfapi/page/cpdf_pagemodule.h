@@ -7,13 +7,21 @@
 #ifndef CORE_FPDFAPI_PAGE_CPDF_PAGEMODULE_H_
 #define CORE_FPDFAPI_PAGE_CPDF_PAGEMODULE_H_
 
+#include <map>
+
+#include "core/fxcrt/bytestring.h"
 #include "core/fxcrt/retain_ptr.h"
+#include "base/span.h"
 
 class CPDF_Document;
 class CPDF_ColorSpace;
 class CPDF_DeviceCS;
 class CPDF_PatternCS;
 
+namespace fxcodec {
+class CLcmsCmm;
+}  // namespace fxcodec
+
 class CPDF_PageModule {
  public:
   // Per-process singleton managed by callers.
@@ -24,6 +32,13 @@ class CPDF_PageModule {
   RetainPtr<CPDF_ColorSpace> GetStockCS(int family);
   void ClearStockFont(CPDF_Document* pDoc);
 
+  // Returns the sRGB transform for the ICC profile in |span|, whose SHA-1 is
+  // |digest|. Documents and objects embedding the same profile share one
+  // transform instead of each building it with lcms.
+  RetainPtr<fxcodec::CLcmsCmm> GetIccTransform(
+      const ByteString& digest,
+      pdfium::span<const uint8_t> span);
+
  private:
   CPDF_PageModule();
   ~CPDF_PageModule();
@@ -32,6 +47,7 @@ class CPDF_PageModule {
   RetainPtr<CPDF_DeviceCS> m_StockRGBCS;
   RetainPtr<CPDF_DeviceCS> m_StockCMYKCS;
   RetainPtr<CPDF_PatternCS> m_StockPatternCS;
+  std::map<ByteString, RetainPtr<fxcodec::CLcmsCmm>> m_IccTransformMap;
 };
 
 #endif  // CORE_FPDFAPI_PAGE_CPDF_PAGEMODULE_H_
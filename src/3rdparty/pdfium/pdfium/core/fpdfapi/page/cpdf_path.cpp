@@ -54,13 +54,14 @@ void CPDF_Path::AppendRect(float left, float bottom, float right, float top) {
 }
 
 void CPDF_Path::AppendPoint(const CFX_PointF& point, FXPT_TYPE type) {
-  CFX_PathData data;
-  data.AppendPoint(point, type);
-  Append(&data, nullptr);
+  m_Ref.GetPrivateCopy()->AppendPoint(point, type);
 }
 
 void CPDF_Path::AppendPointAndClose(const CFX_PointF& point, FXPT_TYPE type) {
-  CFX_PathData data;
-  data.AppendPointAndClose(point, type);
-  Append(&data, nullptr);
+  m_Ref.GetPrivateCopy()->AppendPointAndClose(point, type);
+}
+
+void CPDF_Path::AppendPoints(pdfium::span<const FX_PATHPOINT> points) {
+  std::vector<FX_PATHPOINT>& dest = m_Ref.GetPrivateCopy()->GetPoints();
+  dest.insert(dest.end(), points.begin(), points.end());
 }
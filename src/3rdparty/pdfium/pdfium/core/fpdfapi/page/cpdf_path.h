@@ -12,6 +12,7 @@
 #include "core/fxcrt/fx_system.h"
 #include "core/fxcrt/shared_copy_on_write.h"
 #include "core/fxge/cfx_pathdata.h"
+#include "base/span.h"
 
 class CPDF_Path {
  public:
@@ -37,6 +38,7 @@ class CPDF_Path {
   void AppendRect(float left, float bottom, float right, float top);
   void AppendPoint(const CFX_PointF& point, FXPT_TYPE type);
   void AppendPointAndClose(const CFX_PointF& point, FXPT_TYPE type);
+  void AppendPoints(pdfium::span<const FX_PATHPOINT> points);
 
   // TODO(tsepez): Remove when all access thru this class.
   const CFX_PathData* GetObject() const { return m_Ref.GetObject(); }
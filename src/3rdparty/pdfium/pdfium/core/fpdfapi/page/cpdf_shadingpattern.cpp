@@ -43,6 +43,18 @@ CPDF_ShadingPattern* CPDF_ShadingPattern::AsShadingPattern() {
   return this;
 }
 
+const CPDF_ShadingPattern::ColorTable* CPDF_ShadingPattern::GetColorTable(
+    int alpha) const {
+  auto it = m_ColorTables.find(alpha);
+  return it != m_ColorTables.end() ? &it->second : nullptr;
+}
+
+const CPDF_ShadingPattern::ColorTable& CPDF_ShadingPattern::SetColorTable(
+    int alpha,
+    const ColorTable& table) const {
+  return m_ColorTables[alpha] = table;
+}
+
 bool CPDF_ShadingPattern::Load() {
   if (m_ShadingType != kInvalidShading)
     return true;
@@ -7,6 +7,8 @@
 #ifndef CORE_FPDFAPI_PAGE_CPDF_SHADINGPATTERN_H_
 #define CORE_FPDFAPI_PAGE_CPDF_SHADINGPATTERN_H_
 
+#include <array>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -38,6 +40,10 @@ class CPDF_Object;
 class CPDF_ShadingPattern final : public CPDF_Pattern {
  public:
   CONSTRUCT_VIA_MAKE_RETAIN;
+
+  // Colors sampled along the shading's domain, as used by the renderer for
+  // axial and radial shadings.
+  using ColorTable = std::array<uint32_t, 256>;
   ~CPDF_ShadingPattern() override;
 
   // CPDF_Pattern:
@@ -59,6 +65,12 @@ class CPDF_ShadingPattern final : public CPDF_Pattern {
     return m_pFunctions;
   }
 
+  // The pattern outlives page renders through the document's page data, so
+  // color tables are kept here to spare redraws re-evaluating the functions.
+  // They are keyed by the alpha baked into them.
+  const ColorTable* GetColorTable(int alpha) const;
+  const ColorTable& SetColorTable(int alpha, const ColorTable& table) const;
+
  private:
   CPDF_ShadingPattern(CPDF_Document* pDoc,
                       CPDF_Object* pPatternObj,
@@ -77,6 +89,7 @@ class CPDF_ShadingPattern final : public CPDF_Pattern {
   const bool m_bShading;
   RetainPtr<CPDF_ColorSpace> m_pCS;
   std::vector<std::unique_ptr<CPDF_Function>> m_pFunctions;
+  mutable std::map<int, ColorTable> m_ColorTables;
 };
 
 #endif  // CORE_FPDFAPI_PAGE_CPDF_SHADINGPATTERN_H_
@@ -294,7 +294,14 @@ int CPDF_StreamContentParser::GetNextParamPos() {
 void CPDF_StreamContentParser::AddNameParam(ByteStringView bsName) {
   ContentParam& param = m_ParamBuf[GetNextParamPos()];
   param.m_Type = ContentParam::NAME;
-  param.m_Name = PDF_NameDecode(bsName);
+  param.m_bInlineName =
+      bsName.GetLength() <= kMaxInlineNameLength && !bsName.Contains('#');
+  if (param.m_bInlineName) {
+    param.m_InlineNameLength = bsName.GetLength();
+    std::copy(bsName.begin(), bsName.end(), param.m_InlineName);
+  } else {
+    param.m_Name = PDF_NameDecode(bsName);
+  }
 }
 
 void CPDF_StreamContentParser::AddNumberParam(ByteStringView str) {
@@ -341,7 +348,7 @@ CPDF_Object* CPDF_StreamContentParser::GetObject(uint32_t index) {
   }
   if (param.m_Type == ContentParam::NAME) {
     param.m_Type = ContentParam::OBJECT;
-    param.m_pObject = m_pDocument->New<CPDF_Name>(param.m_Name);
+    param.m_pObject = m_pDocument->New<CPDF_Name>(param.GetName());
     return param.m_pObject.Get();
   }
   if (param.m_Type == ContentParam::OBJECT)
@@ -361,7 +368,7 @@ ByteString CPDF_StreamContentParser::GetString(uint32_t index) const {
 
   const ContentParam& param = m_ParamBuf[real_index];
   if (param.m_Type == ContentParam::NAME)
-    return param.m_Name;
+    return param.GetName();
 
   if (param.m_Type == 0 && param.m_pObject)
     return param.m_pObject->GetString();
@@ -412,133 +419,227 @@ void CPDF_StreamContentParser::SetGraphicStates(CPDF_PageObject* pObj,
   }
 }
 
-// static
-CPDF_StreamContentParser::OpCodes
-CPDF_StreamContentParser::InitializeOpCodes() {
-  return OpCodes({
-      {FXBSTR_ID('"', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_NextLineShowText_Space},
-      {FXBSTR_ID('\'', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_NextLineShowText},
-      {FXBSTR_ID('B', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_FillStrokePath},
-      {FXBSTR_ID('B', '*', 0, 0),
-       &CPDF_StreamContentParser::Handle_EOFillStrokePath},
-      {FXBSTR_ID('B', 'D', 'C', 0),
-       &CPDF_StreamContentParser::Handle_BeginMarkedContent_Dictionary},
-      {FXBSTR_ID('B', 'I', 0, 0), &CPDF_StreamContentParser::Handle_BeginImage},
-      {FXBSTR_ID('B', 'M', 'C', 0),
-       &CPDF_StreamContentParser::Handle_BeginMarkedContent},
-      {FXBSTR_ID('B', 'T', 0, 0), &CPDF_StreamContentParser::Handle_BeginText},
-      {FXBSTR_ID('C', 'S', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetColorSpace_Stroke},
-      {FXBSTR_ID('D', 'P', 0, 0),
-       &CPDF_StreamContentParser::Handle_MarkPlace_Dictionary},
-      {FXBSTR_ID('D', 'o', 0, 0),
-       &CPDF_StreamContentParser::Handle_ExecuteXObject},
-      {FXBSTR_ID('E', 'I', 0, 0), &CPDF_StreamContentParser::Handle_EndImage},
-      {FXBSTR_ID('E', 'M', 'C', 0),
-       &CPDF_StreamContentParser::Handle_EndMarkedContent},
-      {FXBSTR_ID('E', 'T', 0, 0), &CPDF_StreamContentParser::Handle_EndText},
-      {FXBSTR_ID('F', 0, 0, 0), &CPDF_StreamContentParser::Handle_FillPathOld},
-      {FXBSTR_ID('G', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_SetGray_Stroke},
-      {FXBSTR_ID('I', 'D', 0, 0),
-       &CPDF_StreamContentParser::Handle_BeginImageData},
-      {FXBSTR_ID('J', 0, 0, 0), &CPDF_StreamContentParser::Handle_SetLineCap},
-      {FXBSTR_ID('K', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_SetCMYKColor_Stroke},
-      {FXBSTR_ID('M', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_SetMiterLimit},
-      {FXBSTR_ID('M', 'P', 0, 0), &CPDF_StreamContentParser::Handle_MarkPlace},
-      {FXBSTR_ID('Q', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_RestoreGraphState},
-      {FXBSTR_ID('R', 'G', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetRGBColor_Stroke},
-      {FXBSTR_ID('S', 0, 0, 0), &CPDF_StreamContentParser::Handle_StrokePath},
-      {FXBSTR_ID('S', 'C', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetColor_Stroke},
-      {FXBSTR_ID('S', 'C', 'N', 0),
-       &CPDF_StreamContentParser::Handle_SetColorPS_Stroke},
-      {FXBSTR_ID('T', '*', 0, 0),
-       &CPDF_StreamContentParser::Handle_MoveToNextLine},
-      {FXBSTR_ID('T', 'D', 0, 0),
-       &CPDF_StreamContentParser::Handle_MoveTextPoint_SetLeading},
-      {FXBSTR_ID('T', 'J', 0, 0),
-       &CPDF_StreamContentParser::Handle_ShowText_Positioning},
-      {FXBSTR_ID('T', 'L', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetTextLeading},
-      {FXBSTR_ID('T', 'c', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetCharSpace},
-      {FXBSTR_ID('T', 'd', 0, 0),
-       &CPDF_StreamContentParser::Handle_MoveTextPoint},
-      {FXBSTR_ID('T', 'f', 0, 0), &CPDF_StreamContentParser::Handle_SetFont},
-      {FXBSTR_ID('T', 'j', 0, 0), &CPDF_StreamContentParser::Handle_ShowText},
-      {FXBSTR_ID('T', 'm', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetTextMatrix},
-      {FXBSTR_ID('T', 'r', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetTextRenderMode},
-      {FXBSTR_ID('T', 's', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetTextRise},
-      {FXBSTR_ID('T', 'w', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetWordSpace},
-      {FXBSTR_ID('T', 'z', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetHorzScale},
-      {FXBSTR_ID('W', 0, 0, 0), &CPDF_StreamContentParser::Handle_Clip},
-      {FXBSTR_ID('W', '*', 0, 0), &CPDF_StreamContentParser::Handle_EOClip},
-      {FXBSTR_ID('b', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_CloseFillStrokePath},
-      {FXBSTR_ID('b', '*', 0, 0),
-       &CPDF_StreamContentParser::Handle_CloseEOFillStrokePath},
-      {FXBSTR_ID('c', 0, 0, 0), &CPDF_StreamContentParser::Handle_CurveTo_123},
-      {FXBSTR_ID('c', 'm', 0, 0),
-       &CPDF_StreamContentParser::Handle_ConcatMatrix},
-      {FXBSTR_ID('c', 's', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetColorSpace_Fill},
-      {FXBSTR_ID('d', 0, 0, 0), &CPDF_StreamContentParser::Handle_SetDash},
-      {FXBSTR_ID('d', '0', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetCharWidth},
-      {FXBSTR_ID('d', '1', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetCachedDevice},
-      {FXBSTR_ID('f', 0, 0, 0), &CPDF_StreamContentParser::Handle_FillPath},
-      {FXBSTR_ID('f', '*', 0, 0), &CPDF_StreamContentParser::Handle_EOFillPath},
-      {FXBSTR_ID('g', 0, 0, 0), &CPDF_StreamContentParser::Handle_SetGray_Fill},
-      {FXBSTR_ID('g', 's', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetExtendGraphState},
-      {FXBSTR_ID('h', 0, 0, 0), &CPDF_StreamContentParser::Handle_ClosePath},
-      {FXBSTR_ID('i', 0, 0, 0), &CPDF_StreamContentParser::Handle_SetFlat},
-      {FXBSTR_ID('j', 0, 0, 0), &CPDF_StreamContentParser::Handle_SetLineJoin},
-      {FXBSTR_ID('k', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_SetCMYKColor_Fill},
-      {FXBSTR_ID('l', 0, 0, 0), &CPDF_StreamContentParser::Handle_LineTo},
-      {FXBSTR_ID('m', 0, 0, 0), &CPDF_StreamContentParser::Handle_MoveTo},
-      {FXBSTR_ID('n', 0, 0, 0), &CPDF_StreamContentParser::Handle_EndPath},
-      {FXBSTR_ID('q', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_SaveGraphState},
-      {FXBSTR_ID('r', 'e', 0, 0), &CPDF_StreamContentParser::Handle_Rectangle},
-      {FXBSTR_ID('r', 'g', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetRGBColor_Fill},
-      {FXBSTR_ID('r', 'i', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetRenderIntent},
-      {FXBSTR_ID('s', 0, 0, 0),
-       &CPDF_StreamContentParser::Handle_CloseStrokePath},
-      {FXBSTR_ID('s', 'c', 0, 0),
-       &CPDF_StreamContentParser::Handle_SetColor_Fill},
-      {FXBSTR_ID('s', 'c', 'n', 0),
-       &CPDF_StreamContentParser::Handle_SetColorPS_Fill},
-      {FXBSTR_ID('s', 'h', 0, 0), &CPDF_StreamContentParser::Handle_ShadeFill},
-      {FXBSTR_ID('v', 0, 0, 0), &CPDF_StreamContentParser::Handle_CurveTo_23},
-      {FXBSTR_ID('w', 0, 0, 0), &CPDF_StreamContentParser::Handle_SetLineWidth},
-      {FXBSTR_ID('y', 0, 0, 0), &CPDF_StreamContentParser::Handle_CurveTo_13},
-  });
-}
-
 void CPDF_StreamContentParser::OnOperator(ByteStringView op) {
-  static const OpCodes s_OpCodes = InitializeOpCodes();
-
-  auto it = s_OpCodes.find(op.GetID());
-  if (it != s_OpCodes.end())
-    (this->*it->second)();
+  // Operators are dispatched on their packed ID. The compiler lowers this to
+  // a jump table or a small decision tree, so no lookup structure is built or
+  // walked at runtime.
+  switch (op.GetID()) {
+    case FXBSTR_ID('"', 0, 0, 0):
+      Handle_NextLineShowText_Space();
+      break;
+    case FXBSTR_ID('\'', 0, 0, 0):
+      Handle_NextLineShowText();
+      break;
+    case FXBSTR_ID('B', 0, 0, 0):
+      Handle_FillStrokePath();
+      break;
+    case FXBSTR_ID('B', '*', 0, 0):
+      Handle_EOFillStrokePath();
+      break;
+    case FXBSTR_ID('B', 'D', 'C', 0):
+      Handle_BeginMarkedContent_Dictionary();
+      break;
+    case FXBSTR_ID('B', 'I', 0, 0):
+      Handle_BeginImage();
+      break;
+    case FXBSTR_ID('B', 'M', 'C', 0):
+      Handle_BeginMarkedContent();
+      break;
+    case FXBSTR_ID('B', 'T', 0, 0):
+      Handle_BeginText();
+      break;
+    case FXBSTR_ID('C', 'S', 0, 0):
+      Handle_SetColorSpace_Stroke();
+      break;
+    case FXBSTR_ID('D', 'P', 0, 0):
+      Handle_MarkPlace_Dictionary();
+      break;
+    case FXBSTR_ID('D', 'o', 0, 0):
+      Handle_ExecuteXObject();
+      break;
+    case FXBSTR_ID('E', 'I', 0, 0):
+      Handle_EndImage();
+      break;
+    case FXBSTR_ID('E', 'M', 'C', 0):
+      Handle_EndMarkedContent();
+      break;
+    case FXBSTR_ID('E', 'T', 0, 0):
+      Handle_EndText();
+      break;
+    case FXBSTR_ID('F', 0, 0, 0):
+      Handle_FillPathOld();
+      break;
+    case FXBSTR_ID('G', 0, 0, 0):
+      Handle_SetGray_Stroke();
+      break;
+    case FXBSTR_ID('I', 'D', 0, 0):
+      Handle_BeginImageData();
+      break;
+    case FXBSTR_ID('J', 0, 0, 0):
+      Handle_SetLineCap();
+      break;
+    case FXBSTR_ID('K', 0, 0, 0):
+      Handle_SetCMYKColor_Stroke();
+      break;
+    case FXBSTR_ID('M', 0, 0, 0):
+      Handle_SetMiterLimit();
+      break;
+    case FXBSTR_ID('M', 'P', 0, 0):
+      Handle_MarkPlace();
+      break;
+    case FXBSTR_ID('Q', 0, 0, 0):
+      Handle_RestoreGraphState();
+      break;
+    case FXBSTR_ID('R', 'G', 0, 0):
+      Handle_SetRGBColor_Stroke();
+      break;
+    case FXBSTR_ID('S', 0, 0, 0):
+      Handle_StrokePath();
+      break;
+    case FXBSTR_ID('S', 'C', 0, 0):
+      Handle_SetColor_Stroke();
+      break;
+    case FXBSTR_ID('S', 'C', 'N', 0):
+      Handle_SetColorPS_Stroke();
+      break;
+    case FXBSTR_ID('T', '*', 0, 0):
+      Handle_MoveToNextLine();
+      break;
+    case FXBSTR_ID('T', 'D', 0, 0):
+      Handle_MoveTextPoint_SetLeading();
+      break;
+    case FXBSTR_ID('T', 'J', 0, 0):
+      Handle_ShowText_Positioning();
+      break;
+    case FXBSTR_ID('T', 'L', 0, 0):
+      Handle_SetTextLeading();
+      break;
+    case FXBSTR_ID('T', 'c', 0, 0):
+      Handle_SetCharSpace();
+      break;
+    case FXBSTR_ID('T', 'd', 0, 0):
+      Handle_MoveTextPoint();
+      break;
+    case FXBSTR_ID('T', 'f', 0, 0):
+      Handle_SetFont();
+      break;
+    case FXBSTR_ID('T', 'j', 0, 0):
+      Handle_ShowText();
+      break;
+    case FXBSTR_ID('T', 'm', 0, 0):
+      Handle_SetTextMatrix();
+      break;
+    case FXBSTR_ID('T', 'r', 0, 0):
+      Handle_SetTextRenderMode();
+      break;
+    case FXBSTR_ID('T', 's', 0, 0):
+      Handle_SetTextRise();
+      break;
+    case FXBSTR_ID('T', 'w', 0, 0):
+      Handle_SetWordSpace();
+      break;
+    case FXBSTR_ID('T', 'z', 0, 0):
+      Handle_SetHorzScale();
+      break;
+    case FXBSTR_ID('W', 0, 0, 0):
+      Handle_Clip();
+      break;
+    case FXBSTR_ID('W', '*', 0, 0):
+      Handle_EOClip();
+      break;
+    case FXBSTR_ID('b', 0, 0, 0):
+      Handle_CloseFillStrokePath();
+      break;
+    case FXBSTR_ID('b', '*', 0, 0):
+      Handle_CloseEOFillStrokePath();
+      break;
+    case FXBSTR_ID('c', 0, 0, 0):
+      Handle_CurveTo_123();
+      break;
+    case FXBSTR_ID('c', 'm', 0, 0):
+      Handle_ConcatMatrix();
+      break;
+    case FXBSTR_ID('c', 's', 0, 0):
+      Handle_SetColorSpace_Fill();
+      break;
+    case FXBSTR_ID('d', 0, 0, 0):
+      Handle_SetDash();
+      break;
+    case FXBSTR_ID('d', '0', 0, 0):
+      Handle_SetCharWidth();
+      break;
+    case FXBSTR_ID('d', '1', 0, 0):
+      Handle_SetCachedDevice();
+      break;
+    case FXBSTR_ID('f', 0, 0, 0):
+      Handle_FillPath();
+      break;
+    case FXBSTR_ID('f', '*', 0, 0):
+      Handle_EOFillPath();
+      break;
+    case FXBSTR_ID('g', 0, 0, 0):
+      Handle_SetGray_Fill();
+      break;
+    case FXBSTR_ID('g', 's', 0, 0):
+      Handle_SetExtendGraphState();
+      break;
+    case FXBSTR_ID('h', 0, 0, 0):
+      Handle_ClosePath();
+      break;
+    case FXBSTR_ID('i', 0, 0, 0):
+      Handle_SetFlat();
+      break;
+    case FXBSTR_ID('j', 0, 0, 0):
+      Handle_SetLineJoin();
+      break;
+    case FXBSTR_ID('k', 0, 0, 0):
+      Handle_SetCMYKColor_Fill();
+      break;
+    case FXBSTR_ID('l', 0, 0, 0):
+      Handle_LineTo();
+      break;
+    case FXBSTR_ID('m', 0, 0, 0):
+      Handle_MoveTo();
+      break;
+    case FXBSTR_ID('n', 0, 0, 0):
+      Handle_EndPath();
+      break;
+    case FXBSTR_ID('q', 0, 0, 0):
+      Handle_SaveGraphState();
+      break;
+    case FXBSTR_ID('r', 'e', 0, 0):
+      Handle_Rectangle();
+      break;
+    case FXBSTR_ID('r', 'g', 0, 0):
+      Handle_SetRGBColor_Fill();
+      break;
+    case FXBSTR_ID('r', 'i', 0, 0):
+      Handle_SetRenderIntent();
+      break;
+    case FXBSTR_ID('s', 0, 0, 0):
+      Handle_CloseStrokePath();
+      break;
+    case FXBSTR_ID('s', 'c', 0, 0):
+      Handle_SetColor_Fill();
+      break;
+    case FXBSTR_ID('s', 'c', 'n', 0):
+      Handle_SetColorPS_Fill();
+      break;
+    case FXBSTR_ID('s', 'h', 0, 0):
+      Handle_ShadeFill();
+      break;
+    case FXBSTR_ID('v', 0, 0, 0):
+      Handle_CurveTo_23();
+      break;
+    case FXBSTR_ID('w', 0, 0, 0):
+      Handle_SetLineWidth();
+      break;
+    case FXBSTR_ID('y', 0, 0, 0):
+      Handle_CurveTo_13();
+      break;
+    default:
+      break;
+  }
 }
 
 void CPDF_StreamContentParser::Handle_CloseFillStrokePath() {
@@ -1429,15 +1530,14 @@ void CPDF_StreamContentParser::AddPathPoint(float x,
 void CPDF_StreamContentParser::AddPathObject(
     CFX_FillRenderOptions::FillType fill_type,
     bool bStroke) {
-  std::vector<FX_PATHPOINT> path_points;
-  path_points.swap(m_PathPoints);
   CFX_FillRenderOptions::FillType path_clip_type = m_PathClipType;
   m_PathClipType = CFX_FillRenderOptions::FillType::kNoFill;
 
-  if (path_points.empty())
+  if (m_PathPoints.empty())
     return;
 
-  if (path_points.size() == 1) {
+  if (m_PathPoints.size() == 1) {
+    m_PathPoints.clear();
     if (path_clip_type != CFX_FillRenderOptions::FillType::kNoFill) {
       CPDF_Path path;
       path.AppendRect(0, 0, 0, 0);
@@ -1447,16 +1547,14 @@ void CPDF_StreamContentParser::AddPathObject(
     return;
   }
 
-  if (path_points.back().IsTypeAndOpen(FXPT_TYPE::MoveTo))
-    path_points.pop_back();
+  if (m_PathPoints.back().IsTypeAndOpen(FXPT_TYPE::MoveTo))
+    m_PathPoints.pop_back();
 
+  // Copy the points in one go, and keep the capacity of |m_PathPoints| for the
+  // next path instead of growing a fresh vector every time.
   CPDF_Path path;
-  for (const auto& point : path_points) {
-    if (point.m_CloseFigure)
-      path.AppendPointAndClose(point.m_Point, point.m_Type);
-    else
-      path.AppendPoint(point.m_Point, point.m_Type);
-  }
+  path.AppendPoints(m_PathPoints);
+  m_PathPoints.clear();
 
   CFX_Matrix matrix = m_pCurStates->m_CTM * m_mtContentToUser;
   if (bStroke || fill_type != CFX_FillRenderOptions::FillType::kNoFill) {
@@ -1631,3 +1729,9 @@ ByteStringView CPDF_StreamContentParser::FindValueAbbreviationForTesting(
 CPDF_StreamContentParser::ContentParam::ContentParam() {}
 
 CPDF_StreamContentParser::ContentParam::~ContentParam() = default;
+
+ByteString CPDF_StreamContentParser::ContentParam::GetName() const {
+  if (m_bInlineName)
+    return ByteString(m_InlineName, m_InlineNameLength);
+  return m_Name;
+}
@@ -8,7 +8,6 @@
 #define CORE_FPDFAPI_PAGE_CPDF_STREAMCONTENTPARSER_H_
 
 #include <cstdint>
-#include <map>
 #include <memory>
 #include <set>
 #include <stack>
@@ -66,23 +65,29 @@ class CPDF_StreamContentParser {
   static ByteStringView FindValueAbbreviationForTesting(ByteStringView abbr);
 
  private:
+  static constexpr size_t kMaxInlineNameLength = 31;
+
   struct ContentParam {
     enum Type { OBJECT = 0, NUMBER, NAME };
 
     ContentParam();
     ~ContentParam();
 
+    ByteString GetName() const;
+
     Type m_Type;
     FX_Number m_Number;
+    // Short names without escapes are kept in |m_InlineName| so pushing them
+    // does not allocate. Other names are decoded into |m_Name|.
+    bool m_bInlineName = false;
+    uint8_t m_InlineNameLength = 0;
+    char m_InlineName[kMaxInlineNameLength];
     ByteString m_Name;
     RetainPtr<CPDF_Object> m_pObject;
   };
 
   static constexpr int kParamBufSize = 16;
 
-  using OpCodes = std::map<uint32_t, void (CPDF_StreamContentParser::*)()>;
-  static OpCodes InitializeOpCodes();
-
   void AddNameParam(ByteStringView bsName);
   void AddNumberParam(ByteStringView str);
   void AddObjectParam(RetainPtr<CPDF_Object> pObj);
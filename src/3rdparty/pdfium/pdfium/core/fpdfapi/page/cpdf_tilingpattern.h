@@ -7,12 +7,16 @@
 #ifndef CORE_FPDFAPI_PAGE_CPDF_TILINGPATTERN_H_
 #define CORE_FPDFAPI_PAGE_CPDF_TILINGPATTERN_H_
 
+#include <map>
 #include <memory>
 
 #include "core/fpdfapi/page/cpdf_pattern.h"
+#include "core/fxcrt/bytestring.h"
 #include "core/fxcrt/fx_coordinates.h"
 #include "core/fxcrt/fx_system.h"
+#include "core/fxcrt/retain_ptr.h"
 
+class CFX_DIBitmap;
 class CPDF_Document;
 class CPDF_Form;
 class CPDF_Object;
@@ -33,6 +37,16 @@ class CPDF_TilingPattern final : public CPDF_Pattern {
   float x_step() const { return m_XStep; }
   float y_step() const { return m_YStep; }
 
+  // Rendered cells, keyed by a string the renderer builds from everything
+  // their pixels depend on. Cached bitmaps must not be modified. Only the
+  // storage is here; CPDF_DocPageData accounts for and evicts the cells of
+  // all patterns in the document against one budget.
+  struct CachedCell {
+    RetainPtr<CFX_DIBitmap> bitmap;
+    uint64_t last_use = 0;
+  };
+  std::map<ByteString, CachedCell>* cached_cells() { return &m_CachedCells; }
+
  private:
   CPDF_TilingPattern(CPDF_Document* pDoc,
                      CPDF_Object* pPatternObj,
@@ -44,6 +58,7 @@ class CPDF_TilingPattern final : public CPDF_Pattern {
   CFX_FloatRect m_BBox;
   float m_XStep;
   float m_YStep;
+  std::map<ByteString, CachedCell> m_CachedCells;
 };
 
 #endif  // CORE_FPDFAPI_PAGE_CPDF_TILINGPATTERN_H_
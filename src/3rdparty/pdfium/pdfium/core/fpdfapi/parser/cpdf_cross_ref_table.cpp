@@ -4,11 +4,11 @@
 
 #include "core/fpdfapi/parser/cpdf_cross_ref_table.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_parser.h"
-#include "base/stl_util.h"
 
 // static
 std::unique_ptr<CPDF_CrossRefTable> CPDF_CrossRefTable::MergeUp(
@@ -39,7 +39,7 @@ void CPDF_CrossRefTable::AddCompressed(uint32_t obj_num,
     return;
   }
 
-  auto& info = objects_info_[obj_num];
+  auto& info = GetOrAddInfo(obj_num);
   if (info.gennum > 0)
     return;
 
@@ -50,7 +50,7 @@ void CPDF_CrossRefTable::AddCompressed(uint32_t obj_num,
   info.archive_obj_num = archive_obj_num;
   info.gennum = 0;
 
-  objects_info_[archive_obj_num].type = ObjectType::kObjStream;
+  GetOrAddInfo(archive_obj_num).type = ObjectType::kObjStream;
 }
 
 void CPDF_CrossRefTable::AddNormal(uint32_t obj_num,
@@ -61,7 +61,7 @@ void CPDF_CrossRefTable::AddNormal(uint32_t obj_num,
     return;
   }
 
-  auto& info = objects_info_[obj_num];
+  auto& info = GetOrAddInfo(obj_num);
   if (info.gennum > gen_num)
     return;
 
@@ -81,7 +81,7 @@ void CPDF_CrossRefTable::SetFree(uint32_t obj_num) {
     return;
   }
 
-  auto& info = objects_info_[obj_num];
+  auto& info = GetOrAddInfo(obj_num);
   info.type = ObjectType::kFree;
   info.gennum = 0xFFFF;
   info.pos = 0;
@@ -93,12 +93,39 @@ void CPDF_CrossRefTable::SetTrailer(RetainPtr<CPDF_Dictionary> trailer) {
 
 const CPDF_CrossRefTable::ObjectInfo* CPDF_CrossRefTable::GetObjectInfo(
     uint32_t obj_num) const {
-  const auto it = objects_info_.find(obj_num);
-  return it != objects_info_.end() ? &it->second : nullptr;
+  if (obj_num >= objects_info_.size() || !objects_info_[obj_num].is_listed)
+    return nullptr;
+  return &objects_info_[obj_num];
+}
+
+bool CPDF_CrossRefTable::IsEmpty() const {
+  return objects_info_.empty() && !size_last_obj_num_.has_value();
+}
+
+uint32_t CPDF_CrossRefTable::GetLastObjNum() const {
+  uint32_t last_obj_num =
+      objects_info_.empty() ? 0 : objects_info_.size() - 1;
+  if (size_last_obj_num_.has_value())
+    last_obj_num = std::max(last_obj_num, size_last_obj_num_.value());
+  return last_obj_num;
 }
 
 void CPDF_CrossRefTable::Update(
     std::unique_ptr<CPDF_CrossRefTable> new_cross_ref) {
+  if (new_cross_ref->size_last_obj_num_.has_value()) {
+    // The new table's free entry at /Size - 1 overrides an entry listed here
+    // unless the new table lists that object itself.
+    const uint32_t obj_num = new_cross_ref->size_last_obj_num_.value();
+    if (obj_num < objects_info_.size() &&
+        !new_cross_ref->GetObjectInfo(obj_num)) {
+      objects_info_[obj_num] = ObjectInfo();
+      objects_info_[obj_num].is_listed = true;
+    }
+    if (!size_last_obj_num_.has_value() ||
+        size_last_obj_num_.value() < obj_num) {
+      size_last_obj_num_ = obj_num;
+    }
+  }
   UpdateInfo(std::move(new_cross_ref->objects_info_));
   UpdateTrailer(std::move(new_cross_ref->trailer_));
 }
@@ -106,36 +133,47 @@ void CPDF_CrossRefTable::Update(
 void CPDF_CrossRefTable::ShrinkObjectMap(uint32_t objnum) {
   if (objnum == 0) {
     objects_info_.clear();
+    size_last_obj_num_.reset();
     return;
   }
 
-  objects_info_.erase(objects_info_.lower_bound(objnum), objects_info_.end());
+  if (objects_info_.size() > objnum)
+    objects_info_.resize(objnum);
+  while (!objects_info_.empty() && !objects_info_.back().is_listed)
+    objects_info_.pop_back();
+
+  size_last_obj_num_ = objnum - 1;
+}
+
+CPDF_CrossRefTable::ObjectInfo& CPDF_CrossRefTable::GetOrAddInfo(
+    uint32_t obj_num) {
+  if (obj_num >= objects_info_.size())
+    objects_info_.resize(obj_num + 1);
 
-  if (!pdfium::Contains(objects_info_, objnum - 1))
-    objects_info_[objnum - 1].pos = 0;
+  ObjectInfo& info = objects_info_[obj_num];
+  info.is_listed = true;
+  return info;
 }
 
 void CPDF_CrossRefTable::UpdateInfo(
-    std::map<uint32_t, ObjectInfo>&& new_objects_info) {
-  auto cur_it = objects_info_.begin();
-  auto new_it = new_objects_info.begin();
-  while (cur_it != objects_info_.end() && new_it != new_objects_info.end()) {
-    if (cur_it->first == new_it->first) {
-      if (cur_it->second.type == ObjectType::kObjStream &&
-          new_it->second.type == ObjectType::kNormal) {
-        new_it->second.type = ObjectType::kObjStream;
-      }
-      ++cur_it;
-      ++new_it;
-    } else if (cur_it->first < new_it->first) {
-      new_objects_info.insert(new_it, *cur_it);
-      ++cur_it;
-    } else {
-      new_it = new_objects_info.lower_bound(cur_it->first);
+    std::vector<ObjectInfo>&& new_objects_info) {
+  if (new_objects_info.size() < objects_info_.size())
+    new_objects_info.resize(objects_info_.size());
+
+  for (size_t i = 0; i < objects_info_.size(); ++i) {
+    const ObjectInfo& cur_info = objects_info_[i];
+    if (!cur_info.is_listed)
+      continue;
+
+    ObjectInfo& new_info = new_objects_info[i];
+    if (!new_info.is_listed) {
+      new_info = cur_info;
+      continue;
+    }
+    if (cur_info.type == ObjectType::kObjStream &&
+        new_info.type == ObjectType::kNormal) {
+      new_info.type = ObjectType::kObjStream;
     }
-  }
-  for (; cur_it != objects_info_.end(); ++cur_it) {
-    new_objects_info.insert(new_objects_info.end(), *cur_it);
   }
   objects_info_ = std::move(new_objects_info);
 }
@@ -6,11 +6,12 @@
 #define CORE_FPDFAPI_PARSER_CPDF_CROSS_REF_TABLE_H_
 
 #include <cstdint>
-#include <map>
 #include <memory>
+#include <vector>
 
 #include "core/fxcrt/fx_system.h"
 #include "core/fxcrt/retain_ptr.h"
+#include "base/optional.h"
 
 class CPDF_Dictionary;
 
@@ -26,7 +27,8 @@ class CPDF_CrossRefTable {
   };
 
   struct ObjectInfo {
-    ObjectInfo() : pos(0), type(ObjectType::kFree), gennum(0) {}
+    ObjectInfo()
+        : pos(0), type(ObjectType::kFree), gennum(0), is_listed(false) {}
     // if type is ObjectType::kCompressed the archive_obj_num should be used.
     // if type is ObjectType::kNotCompressed the pos should be used.
     // In other cases its are unused.
@@ -36,6 +38,8 @@ class CPDF_CrossRefTable {
     };
     ObjectType type;
     uint16_t gennum;
+    // False for object numbers no cross reference section mentioned.
+    bool is_listed;
   };
 
   // Merge cross reference tables.  Apply top on current.
@@ -57,20 +61,34 @@ class CPDF_CrossRefTable {
 
   const ObjectInfo* GetObjectInfo(uint32_t obj_num) const;
 
-  const std::map<uint32_t, ObjectInfo>& objects_info() const {
-    return objects_info_;
-  }
+  // Indexed by object number. Empty, or ends with a listed entry.
+  const std::vector<ObjectInfo>& objects_info() const { return objects_info_; }
+
+  // True if no object is listed and no /Size has been applied.
+  bool IsEmpty() const;
+
+  // The highest listed object number, or /Size - 1 from ShrinkObjectMap() if
+  // that is higher. 0 if IsEmpty().
+  uint32_t GetLastObjNum() const;
 
   void Update(std::unique_ptr<CPDF_CrossRefTable> new_cross_ref);
 
   void ShrinkObjectMap(uint32_t objnum);
 
  private:
-  void UpdateInfo(std::map<uint32_t, ObjectInfo>&& new_objects_info);
+  ObjectInfo& GetOrAddInfo(uint32_t obj_num);
+  void UpdateInfo(std::vector<ObjectInfo>&& new_objects_info);
   void UpdateTrailer(RetainPtr<CPDF_Dictionary> new_trailer);
 
   RetainPtr<CPDF_Dictionary> trailer_;
-  std::map<uint32_t, ObjectInfo> objects_info_;
+  // Object numbers are capped at CPDF_Parser::kMaxObjectNumber, so a dense
+  // vector stays bounded, and it is far smaller and faster than a tree for
+  // the densely numbered objects real documents have.
+  std::vector<ObjectInfo> objects_info_;
+  // /Size - 1 as last applied by ShrinkObjectMap(). It counts as a free
+  // entry, but is kept out of |objects_info_| so that a huge /Size with few
+  // listed objects does not allocate an entry per object number.
+  Optional<uint32_t> size_last_obj_num_;
 };
 
 #endif  // CORE_FPDFAPI_PARSER_CPDF_CROSS_REF_TABLE_H_
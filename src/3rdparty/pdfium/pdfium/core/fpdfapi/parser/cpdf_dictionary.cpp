@@ -6,6 +6,7 @@
 
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 
+#include <algorithm>
 #include <set>
 #include <utility>
 
@@ -32,7 +33,7 @@ CPDF_Dictionary::~CPDF_Dictionary() {
   // Mark the object as deleted so that it will not be deleted again,
   // and break cyclic references.
   m_ObjNum = kInvalidObjNum;
-  for (auto& it : m_Map) {
+  for (auto& it : m_Entries) {
     if (it.second && it.second->GetObjNum() == kInvalidObjNum)
       it.second.Leak();
   }
@@ -76,15 +77,15 @@ RetainPtr<CPDF_Object> CPDF_Dictionary::CloneNonCyclic(
     if (!pdfium::Contains(*pVisited, it.second.Get())) {
       std::set<const CPDF_Object*> visited(*pVisited);
       if (auto obj = it.second->CloneNonCyclic(bDirect, &visited))
-        pCopy->m_Map.insert(std::make_pair(it.first, std::move(obj)));
+        pCopy->m_Entries.emplace_back(it.first, std::move(obj));
     }
   }
   return pCopy;
 }
 
 const CPDF_Object* CPDF_Dictionary::GetObjectFor(const ByteString& key) const {
-  auto it = m_Map.find(key);
-  return it != m_Map.end() ? it->second.Get() : nullptr;
+  size_t index = Find(key);
+  return index < m_Entries.size() ? m_Entries[index].second.Get() : nullptr;
 }
 
 CPDF_Object* CPDF_Dictionary::GetObjectFor(const ByteString& key) {
@@ -197,7 +198,7 @@ CFX_Matrix CPDF_Dictionary::GetMatrixFor(const ByteString& key) const {
 }
 
 bool CPDF_Dictionary::KeyExist(const ByteString& key) const {
-  return pdfium::Contains(m_Map, key);
+  return Find(key) < m_Entries.size();
 }
 
 std::vector<ByteString> CPDF_Dictionary::GetKeys() const {
@@ -211,13 +212,21 @@ std::vector<ByteString> CPDF_Dictionary::GetKeys() const {
 CPDF_Object* CPDF_Dictionary::SetFor(const ByteString& key,
                                      RetainPtr<CPDF_Object> pObj) {
   CHECK(!IsLocked());
+  size_t index = LowerBound(key);
+  bool bFound = index < m_Entries.size() && m_Entries[index].first == key;
   if (!pObj) {
-    m_Map.erase(key);
+    if (bFound)
+      m_Entries.erase(m_Entries.begin() + index);
     return nullptr;
   }
   ASSERT(pObj->IsInline());
   CPDF_Object* pRet = pObj.Get();
-  m_Map[MaybeIntern(key)] = std::move(pObj);
+  if (bFound) {
+    m_Entries[index].second = std::move(pObj);
+  } else {
+    m_Entries.emplace(m_Entries.begin() + index, MaybeIntern(key),
+                      std::move(pObj));
+  }
   return pRet;
 }
 
@@ -225,21 +234,22 @@ void CPDF_Dictionary::ConvertToIndirectObjectFor(
     const ByteString& key,
     CPDF_IndirectObjectHolder* pHolder) {
   CHECK(!IsLocked());
-  auto it = m_Map.find(key);
-  if (it == m_Map.end() || it->second->IsReference())
+  size_t index = Find(key);
+  if (index == m_Entries.size() || m_Entries[index].second->IsReference())
     return;
 
-  CPDF_Object* pObj = pHolder->AddIndirectObject(std::move(it->second));
-  it->second = pObj->MakeReference(pHolder);
+  CPDF_Object* pObj =
+      pHolder->AddIndirectObject(std::move(m_Entries[index].second));
+  m_Entries[index].second = pObj->MakeReference(pHolder);
 }
 
 RetainPtr<CPDF_Object> CPDF_Dictionary::RemoveFor(const ByteString& key) {
   CHECK(!IsLocked());
   RetainPtr<CPDF_Object> result;
-  auto it = m_Map.find(key);
-  if (it != m_Map.end()) {
-    result = std::move(it->second);
-    m_Map.erase(it);
+  size_t index = Find(key);
+  if (index < m_Entries.size()) {
+    result = std::move(m_Entries[index].second);
+    m_Entries.erase(m_Entries.begin() + index);
   }
   return result;
 }
@@ -247,16 +257,19 @@ RetainPtr<CPDF_Object> CPDF_Dictionary::RemoveFor(const ByteString& key) {
 void CPDF_Dictionary::ReplaceKey(const ByteString& oldkey,
                                  const ByteString& newkey) {
   CHECK(!IsLocked());
-  auto old_it = m_Map.find(oldkey);
-  if (old_it == m_Map.end())
+  size_t old_index = Find(oldkey);
+  if (old_index == m_Entries.size() || oldkey == newkey)
     return;
 
-  auto new_it = m_Map.find(newkey);
-  if (new_it == old_it)
+  RetainPtr<CPDF_Object> pObj = std::move(m_Entries[old_index].second);
+  m_Entries.erase(m_Entries.begin() + old_index);
+  size_t new_index = LowerBound(newkey);
+  if (new_index < m_Entries.size() && m_Entries[new_index].first == newkey) {
+    m_Entries[new_index].second = std::move(pObj);
     return;
-
-  m_Map[MaybeIntern(newkey)] = std::move(old_it->second);
-  m_Map.erase(old_it);
+  }
+  m_Entries.emplace(m_Entries.begin() + new_index, MaybeIntern(newkey),
+                    std::move(pObj));
 }
 
 void CPDF_Dictionary::SetRectFor(const ByteString& key,
@@ -280,9 +293,30 @@ void CPDF_Dictionary::SetMatrixFor(const ByteString& key,
 }
 
 ByteString CPDF_Dictionary::MaybeIntern(const ByteString& str) {
+  if (const ByteString* atom = PDF_FindNameAtom(str.AsStringView()))
+    return *atom;
   return m_pPool ? m_pPool->Intern(str) : str;
 }
 
+size_t CPDF_Dictionary::LowerBound(const ByteString& key) const {
+  // Entries are usually added in key order, so check the end first.
+  if (m_Entries.empty() || m_Entries.back().first < key)
+    return m_Entries.size();
+
+  auto it = std::lower_bound(m_Entries.begin(), m_Entries.end(), key,
+                             [](const Entry& entry, const ByteString& other) {
+                               return entry.first < other;
+                             });
+  return it - m_Entries.begin();
+}
+
+size_t CPDF_Dictionary::Find(const ByteString& key) const {
+  size_t index = LowerBound(key);
+  if (index < m_Entries.size() && m_Entries[index].first == key)
+    return index;
+  return m_Entries.size();
+}
+
 bool CPDF_Dictionary::WriteTo(IFX_ArchiveStream* archive,
                               const CPDF_Encryptor* encryptor) const {
   if (!archive->WriteString("<<"))
@@ -7,7 +7,6 @@
 #ifndef CORE_FPDFAPI_PARSER_CPDF_DICTIONARY_H_
 #define CORE_FPDFAPI_PARSER_CPDF_DICTIONARY_H_
 
-#include <map>
 #include <memory>
 #include <set>
 #include <utility>
@@ -25,8 +24,8 @@ class CPDF_IndirectObjectHolder;
 
 class CPDF_Dictionary final : public CPDF_Object {
  public:
-  using const_iterator =
-      std::map<ByteString, RetainPtr<CPDF_Object>>::const_iterator;
+  using Entry = std::pair<ByteString, RetainPtr<CPDF_Object>>;
+  using const_iterator = std::vector<Entry>::const_iterator;
 
   CONSTRUCT_VIA_MAKE_RETAIN;
 
@@ -43,7 +42,7 @@ class CPDF_Dictionary final : public CPDF_Object {
 
   bool IsLocked() const { return !!m_LockCount; }
 
-  size_t size() const { return m_Map.size(); }
+  size_t size() const { return m_Entries.size(); }
   const CPDF_Object* GetObjectFor(const ByteString& key) const;
   CPDF_Object* GetObjectFor(const ByteString& key);
   const CPDF_Object* GetDirectObjectFor(const ByteString& key) const;
@@ -125,13 +124,19 @@ class CPDF_Dictionary final : public CPDF_Object {
   ~CPDF_Dictionary() override;
 
   ByteString MaybeIntern(const ByteString& str);
+  // Returns the index of the first entry whose key is not less than |key|.
+  size_t LowerBound(const ByteString& key) const;
+  // Returns the index of the entry for |key|, or size() if there is none.
+  size_t Find(const ByteString& key) const;
   RetainPtr<CPDF_Object> CloneNonCyclic(
       bool bDirect,
       std::set<const CPDF_Object*>* visited) const override;
 
   mutable uint32_t m_LockCount = 0;
   WeakPtr<ByteStringPool> m_pPool;
-  std::map<ByteString, RetainPtr<CPDF_Object>> m_Map;
+  // Sorted by key. Most dictionaries are small and are built in key order or
+  // by cloning, so a sorted vector beats a tree on both lookups and memory.
+  std::vector<Entry> m_Entries;
 };
 
 class CPDF_DictionaryLocker {
@@ -143,11 +148,11 @@ class CPDF_DictionaryLocker {
 
   const_iterator begin() const {
     CHECK(m_pDictionary->IsLocked());
-    return m_pDictionary->m_Map.begin();
+    return m_pDictionary->m_Entries.begin();
   }
   const_iterator end() const {
     CHECK(m_pDictionary->IsLocked());
-    return m_pDictionary->m_Map.end();
+    return m_pDictionary->m_Entries.end();
   }
 
  private:
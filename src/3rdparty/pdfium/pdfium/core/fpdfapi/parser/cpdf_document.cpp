@@ -158,6 +158,7 @@ CPDF_Parser::Error CPDF_Document::LoadLinearizedDoc(
 }
 
 void CPDF_Document::LoadPages() {
+  InvalidatePageIndex();
   const CPDF_LinearizedHeader* linearized_header =
       m_pParser->GetLinearizedHeader();
   if (!linearized_header) {
@@ -190,7 +191,7 @@ CPDF_Dictionary* CPDF_Document::TraversePDFPages(int iPage,
     m_pTreeTraversal.pop_back();
     if (*nPagesToGo != 1)
       return nullptr;
-    m_PageList[iPage] = pPages->GetObjNum();
+    SetPageObjNum(iPage, pPages->GetObjNum());
     return pPages;
   }
   if (level >= kMaxPageLevel) {
@@ -214,7 +215,7 @@ CPDF_Dictionary* CPDF_Document::TraversePDFPages(int iPage,
       continue;
     }
     if (!pKid->KeyExist("Kids")) {
-      m_PageList[iPage - (*nPagesToGo) + 1] = pKid->GetObjNum();
+      SetPageObjNum(iPage - (*nPagesToGo) + 1, pKid->GetObjNum());
       (*nPagesToGo)--;
       m_pTreeTraversal[level].second++;
       if (*nPagesToGo == 0) {
@@ -249,6 +250,34 @@ void CPDF_Document::ResetTraversal() {
   m_pTreeTraversal.clear();
 }
 
+void CPDF_Document::BuildPageIndex() {
+  m_bPageIndexBuilt = true;
+  m_PageIndex.clear();
+  for (int i = 0; i < GetPageCount(); ++i) {
+    if (!m_PageList[i])
+      GetPageDictionary(i);
+    if (m_PageList[i])
+      AddToPageIndex(m_PageList[i], i);
+  }
+}
+
+void CPDF_Document::AddToPageIndex(uint32_t objnum, int iPage) {
+  // Keep the first page for an objnum, as a linear search would. An entry
+  // that no longer matches |m_PageList| is replaced.
+  auto result = m_PageIndex.emplace(objnum, iPage);
+  int& index = result.first->second;
+  if (!result.second &&
+      (iPage < index || !pdfium::IndexInBounds(m_PageList, index) ||
+       m_PageList[index] != objnum)) {
+    index = iPage;
+  }
+}
+
+void CPDF_Document::InvalidatePageIndex() {
+  m_bPageIndexBuilt = false;
+  m_PageIndex.clear();
+}
+
 void CPDF_Document::SetParser(std::unique_ptr<CPDF_Parser> pParser) {
   ASSERT(!m_pParser);
   m_pParser = std::move(pParser);
@@ -301,9 +330,22 @@ CPDF_Dictionary* CPDF_Document::GetPageDictionary(int iPage) {
 
 void CPDF_Document::SetPageObjNum(int iPage, uint32_t objNum) {
   m_PageList[iPage] = objNum;
+  if (m_bPageIndexBuilt)
+    AddToPageIndex(objNum, iPage);
 }
 
 int CPDF_Document::GetPageIndex(uint32_t objnum) {
+  if (!m_bPageIndexBuilt)
+    BuildPageIndex();
+
+  auto it = m_PageIndex.find(objnum);
+  if (it != m_PageIndex.end() &&
+      pdfium::IndexInBounds(m_PageList, it->second) &&
+      m_PageList[it->second] == objnum) {
+    return it->second;
+  }
+
+  // Not a page reached by traversing the page tree, or the index is stale.
   uint32_t skip_count = 0;
   bool bSkipped = false;
   for (uint32_t i = 0; i < m_PageList.size(); ++i) {
@@ -327,8 +369,9 @@ int CPDF_Document::GetPageIndex(uint32_t objnum) {
     return -1;
 
   // Only update |m_PageList| when |objnum| points to a /Page object.
-  if (IsValidPageObject(GetOrParseIndirectObject(objnum)))
-    m_PageList[found_index] = objnum;
+  if (IsValidPageObject(GetOrParseIndirectObject(objnum))) {
+    SetPageObjNum(found_index, objnum);
+  }
   return found_index;
 }
 
@@ -452,6 +495,7 @@ bool CPDF_Document::InsertNewPage(int iPage, CPDF_Dictionary* pPageDict) {
       return false;
   }
   m_PageList.insert(m_PageList.begin() + iPage, pPageDict->GetObjNum());
+  InvalidatePageIndex();
   return true;
 }
 
@@ -486,6 +530,7 @@ void CPDF_Document::DeletePage(int iPage) {
     return;
 
   m_PageList.erase(m_PageList.begin() + iPage);
+  InvalidatePageIndex();
 }
 
 void CPDF_Document::SetRootForTesting(CPDF_Dictionary* root) {
@@ -494,6 +539,7 @@ void CPDF_Document::SetRootForTesting(CPDF_Dictionary* root) {
 
 void CPDF_Document::ResizePageListForTesting(size_t size) {
   m_PageList.resize(size);
+  InvalidatePageIndex();
 }
 
 CPDF_Document::StockFontClearer::StockFontClearer(
@@ -9,6 +9,7 @@
 
 #include <memory>
 #include <set>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -165,6 +166,13 @@ class CPDF_Document : public Observable,
                            std::set<CPDF_Dictionary*>* pVisited);
   bool InsertNewPage(int iPage, CPDF_Dictionary* pPageDict);
   void ResetTraversal();
+  // Loads every page dictionary not yet in |m_PageList|, then fills
+  // |m_PageIndex| from |m_PageList|.
+  void BuildPageIndex();
+  // Records |iPage| for |objnum| unless the index already has a valid, lower
+  // page for it.
+  void AddToPageIndex(uint32_t objnum, int iPage);
+  void InvalidatePageIndex();
   CPDF_Parser::Error HandleLoadResult(CPDF_Parser::Error error);
 
   std::unique_ptr<CPDF_Parser> m_pParser;
@@ -192,6 +200,12 @@ class CPDF_Document : public Observable,
   std::unique_ptr<LinkListIface> m_pLinksContext;
   std::vector<uint32_t> m_PageList;  // Page number to page's dict objnum.
 
+  // Page's dict objnum to page number, the reverse of |m_PageList|. Built on
+  // the first GetPageIndex() call and dropped when pages move. Entries are
+  // checked against |m_PageList| before use.
+  std::unordered_map<uint32_t, int> m_PageIndex;
+  bool m_bPageIndexBuilt = false;
+
   // Must be second to last.
   StockFontClearer m_StockFontClearer;
 
@@ -12,7 +12,9 @@
 
 CPDF_Name::CPDF_Name(WeakPtr<ByteStringPool> pPool, const ByteString& str)
     : m_Name(str) {
-  if (pPool)
+  if (const ByteString* atom = PDF_FindNameAtom(m_Name.AsStringView()))
+    m_Name = *atom;
+  else if (pPool)
     m_Name = pPool->Intern(m_Name);
 }
 
@@ -99,6 +99,7 @@ void CPDF_ObjectStream::Init(const CPDF_Stream* stream) {
     const uint32_t data_size = stream_acc->GetSize();
     data_stream_ = pdfium::MakeRetain<CFX_ReadOnlyMemoryStream>(
         stream_acc->DetachData(), data_size);
+    decoded_size_ = data_size;
   }
 
   CPDF_SyntaxParser syntax(data_stream_);
@@ -34,6 +34,8 @@ class CPDF_ObjectStream {
   const std::map<uint32_t, uint32_t>& objects_offsets() const {
     return objects_offsets_;
   }
+  // Size of the decoded stream data held in memory.
+  size_t decoded_size() const { return decoded_size_; }
 
  protected:
   explicit CPDF_ObjectStream(const CPDF_Stream* stream);
@@ -48,6 +50,7 @@ class CPDF_ObjectStream {
 
   RetainPtr<IFX_SeekableReadStream> data_stream_;
   int first_object_offset_ = 0;
+  size_t decoded_size_ = 0;
   std::map<uint32_t, uint32_t> objects_offsets_;
 };
 
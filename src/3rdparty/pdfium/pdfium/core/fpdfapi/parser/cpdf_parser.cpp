@@ -70,10 +70,19 @@ CPDF_Parser::~CPDF_Parser() {
   ReleaseEncryptHandler();
 }
 
+CPDF_Parser::ObjectStreamCacheEntry::ObjectStreamCacheEntry() = default;
+
+CPDF_Parser::ObjectStreamCacheEntry::ObjectStreamCacheEntry(
+    ObjectStreamCacheEntry&& that) = default;
+
+CPDF_Parser::ObjectStreamCacheEntry::~ObjectStreamCacheEntry() = default;
+
+CPDF_Parser::ObjectStreamCacheEntry&
+CPDF_Parser::ObjectStreamCacheEntry::operator=(ObjectStreamCacheEntry&& that) =
+    default;
+
 uint32_t CPDF_Parser::GetLastObjNum() const {
-  return m_CrossRefTable->objects_info().empty()
-             ? 0
-             : m_CrossRefTable->objects_info().rbegin()->first;
+  return m_CrossRefTable->GetLastObjNum();
 }
 
 bool CPDF_Parser::IsValidObjectNumber(uint32_t objnum) const {
@@ -262,17 +271,18 @@ void CPDF_Parser::ReleaseEncryptHandler() {
 // with the objects. crbug/602650 showed a case where object numbers
 // in the cross reference table are all off by one.
 bool CPDF_Parser::VerifyCrossRefV4() {
-  for (const auto& it : m_CrossRefTable->objects_info()) {
-    if (it.second.pos == 0)
+  const auto& objects_info = m_CrossRefTable->objects_info();
+  for (uint32_t objnum = 0; objnum < objects_info.size(); ++objnum) {
+    if (objects_info[objnum].pos == 0)
       continue;
     // Find the first non-zero position.
     FX_FILESIZE SavedPos = m_pSyntax->GetPos();
-    m_pSyntax->SetPos(it.second.pos);
+    m_pSyntax->SetPos(objects_info[objnum].pos);
     bool is_num = false;
     ByteString num_str = m_pSyntax->GetNextWord(&is_num);
     m_pSyntax->SetPos(SavedPos);
     if (!is_num || num_str.IsEmpty() ||
-        FXSYS_atoui(num_str.c_str()) != it.first) {
+        FXSYS_atoui(num_str.c_str()) != objnum) {
       // If the object number read doesn't match the one stored,
       // something is wrong with the cross reference table.
       return false;
@@ -576,7 +586,7 @@ bool CPDF_Parser::LoadAllCrossRefV5(FX_FILESIZE xref_offset) {
     if (pdfium::Contains(seen_xref_offset, xref_offset))
       return false;
   }
-  m_ObjectStreamMap.clear();
+  ClearObjectStreamCache();
   m_bXRefStream = true;
   return true;
 }
@@ -584,16 +594,18 @@ bool CPDF_Parser::LoadAllCrossRefV5(FX_FILESIZE xref_offset) {
 bool CPDF_Parser::RebuildCrossRef() {
   auto cross_ref_table = std::make_unique<CPDF_CrossRefTable>();
 
-  const uint32_t kBufferSize = 4096;
+  // The whole file is read front to back, so read it in large blocks. Most
+  // of it is stream data that is skipped without being tokenized.
+  const uint32_t kBufferSize = 1024 * 1024;
   m_pSyntax->SetReadBufferSize(kBufferSize);
   m_pSyntax->SetPos(0);
 
   bool bIsNumber;
   std::vector<std::pair<uint32_t, FX_FILESIZE>> numbers;
-  for (ByteString word = m_pSyntax->GetNextWord(&bIsNumber); !word.IsEmpty();
-       word = m_pSyntax->GetNextWord(&bIsNumber)) {
+  for (ByteStringView word = m_pSyntax->GetNextWordView(&bIsNumber);
+       !word.IsEmpty(); word = m_pSyntax->GetNextWordView(&bIsNumber)) {
     if (bIsNumber) {
-      numbers.emplace_back(FXSYS_atoui(word.c_str()),
+      numbers.emplace_back(FXSYS_atoui(ByteString(word).c_str()),
                            m_pSyntax->GetPos() - word.GetLength());
       if (numbers.size() > 2u)
         numbers.erase(numbers.begin());
@@ -649,7 +661,7 @@ bool CPDF_Parser::RebuildCrossRef() {
   // Resore default buffer size.
   m_pSyntax->SetReadBufferSize(CPDF_Stream::kFileBufSize);
 
-  return GetTrailer() && !m_CrossRefTable->objects_info().empty();
+  return GetTrailer() && !m_CrossRefTable->IsEmpty();
 }
 
 bool CPDF_Parser::LoadCrossRefV5(FX_FILESIZE* pos, bool bMainXRef) {
@@ -736,7 +748,7 @@ bool CPDF_Parser::LoadCrossRefV5(FX_FILESIZE* pos, bool bMainXRef) {
     FX_SAFE_UINT32 dwMaxObjNum = startnum;
     dwMaxObjNum += count;
     uint32_t dwV5Size =
-        m_CrossRefTable->objects_info().empty() ? 0 : GetLastObjNum() + 1;
+        m_CrossRefTable->IsEmpty() ? 0 : GetLastObjNum() + 1;
     if (!dwMaxObjNum.IsValid() || dwMaxObjNum.ValueOrDie() > dwV5Size)
       continue;
 
@@ -888,9 +900,11 @@ const CPDF_ObjectStream* CPDF_Parser::GetObjectStream(uint32_t object_number) {
   pdfium::ScopedSetInsertion<uint32_t> local_insert(&m_ParsingObjNums,
                                                     object_number);
 
-  auto it = m_ObjectStreamMap.find(object_number);
-  if (it != m_ObjectStreamMap.end())
-    return it->second.get();
+  auto it = m_ObjectStreamCache.find(object_number);
+  if (it != m_ObjectStreamCache.end()) {
+    it->second.last_use = ++m_ObjectStreamUseCount;
+    return it->second.stream.get();
+  }
 
   const auto* info = m_CrossRefTable->GetObjectInfo(object_number);
   if (!info || info->type != ObjectType::kObjStream)
@@ -905,14 +919,42 @@ const CPDF_ObjectStream* CPDF_Parser::GetObjectStream(uint32_t object_number) {
   if (!object)
     return nullptr;
 
-  std::unique_ptr<CPDF_ObjectStream> objs_stream =
-      CPDF_ObjectStream::Create(ToStream(object.Get()));
-  const CPDF_ObjectStream* result = objs_stream.get();
-  m_ObjectStreamMap[object_number] = std::move(objs_stream);
-
+  ObjectStreamCacheEntry& entry = m_ObjectStreamCache[object_number];
+  entry.stream = CPDF_ObjectStream::Create(ToStream(object.Get()));
+  entry.last_use = ++m_ObjectStreamUseCount;
+  const CPDF_ObjectStream* result = entry.stream.get();
+  if (result) {
+    m_ObjectStreamCacheSize += result->decoded_size();
+    TrimObjectStreamCache(object_number);
+  }
   return result;
 }
 
+void CPDF_Parser::ClearObjectStreamCache() {
+  m_ObjectStreamCache.clear();
+  m_ObjectStreamCacheSize = 0;
+}
+
+void CPDF_Parser::TrimObjectStreamCache(uint32_t keep_obj_num) {
+  while (m_ObjectStreamCacheSize > kMaxObjectStreamCacheSize) {
+    auto oldest = m_ObjectStreamCache.end();
+    for (auto it = m_ObjectStreamCache.begin(); it != m_ObjectStreamCache.end();
+         ++it) {
+      if (it->first == keep_obj_num || !it->second.stream)
+        continue;
+      if (oldest == m_ObjectStreamCache.end() ||
+          it->second.last_use < oldest->second.last_use) {
+        oldest = it;
+      }
+    }
+    if (oldest == m_ObjectStreamCache.end())
+      return;
+
+    m_ObjectStreamCacheSize -= oldest->second.stream->decoded_size();
+    m_ObjectStreamCache.erase(oldest);
+  }
+}
+
 RetainPtr<CPDF_Object> CPDF_Parser::ParseIndirectObjectAt(FX_FILESIZE pos,
                                                           uint32_t objnum) {
   const FX_FILESIZE saved_pos = m_pSyntax->GetPos();
@@ -1051,7 +1093,7 @@ bool CPDF_Parser::LoadLinearizedAllCrossRefV5(FX_FILESIZE main_xref_offset) {
     if (pdfium::Contains(seen_xref_offset, xref_offset))
       return false;
   }
-  m_ObjectStreamMap.clear();
+  ClearObjectStreamCache();
   m_bXRefStream = true;
   return true;
 }
@@ -1067,7 +1109,7 @@ CPDF_Parser::Error CPDF_Parser::LoadLinearizedMainXRefTable() {
 
   const AutoRestorer<uint32_t> save_metadata_objnum(&m_MetadataObjnum);
   m_MetadataObjnum = 0;
-  m_ObjectStreamMap.clear();
+  ClearObjectStreamCache();
 
   if (!LoadLinearizedAllCrossRefV4(main_xref_offset) &&
       !LoadLinearizedAllCrossRefV5(main_xref_offset)) {
@@ -197,8 +197,31 @@ private:
     ByteString m_Password;
     std::unique_ptr<CPDF_LinearizedHeader> m_pLinearized;
 
-    // A map of object numbers to indirect streams.
-    std::map<uint32_t, std::unique_ptr<CPDF_ObjectStream>> m_ObjectStreamMap;
+    struct ObjectStreamCacheEntry {
+        ObjectStreamCacheEntry();
+        ObjectStreamCacheEntry(ObjectStreamCacheEntry &&that);
+        ~ObjectStreamCacheEntry();
+
+        ObjectStreamCacheEntry &operator=(ObjectStreamCacheEntry &&that);
+
+        // Null if the object is not a valid object stream.
+        std::unique_ptr<CPDF_ObjectStream> stream;
+        uint64_t last_use = 0;
+    };
+
+    // Upper bound on the decoded data held by |m_ObjectStreamCache|.
+    static constexpr size_t kMaxObjectStreamCacheSize = 32 * 1024 * 1024;
+
+    void ClearObjectStreamCache();
+    // Drops the least recently used object streams, other than
+    // |keep_obj_num|, until the cache fits kMaxObjectStreamCacheSize.
+    void TrimObjectStreamCache(uint32_t keep_obj_num);
+
+    // A map of object numbers to decoded object streams. Streams evicted by
+    // TrimObjectStreamCache() are decoded again when next needed.
+    std::map<uint32_t, ObjectStreamCacheEntry> m_ObjectStreamCache;
+    size_t m_ObjectStreamCacheSize = 0;
+    uint64_t m_ObjectStreamUseCount = 0;
 
     // All indirect object numbers that are being parsed.
     std::set<uint32_t> m_ParsingObjNums;
@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <sstream>
 #include <utility>
+#include <vector>
 
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_boolean.h"
@@ -464,12 +465,15 @@ void CPDF_SyntaxParser::RecordingToNextWord() {
 }
 
 ByteString CPDF_SyntaxParser::GetNextWord(bool* bIsNumber) {
+  return ByteString(GetNextWordView(bIsNumber));
+}
+
+ByteStringView CPDF_SyntaxParser::GetNextWordView(bool* bIsNumber) {
   const CPDF_ReadValidator::Session read_session(GetValidator());
   GetNextWordInternal(bIsNumber);
-  ByteString ret;
-  if (!GetValidator()->has_read_problems())
-    ret = ByteString(m_WordBuffer, m_WordSize);
-  return ret;
+  if (GetValidator()->has_read_problems())
+    return ByteStringView();
+  return ByteStringView(m_WordBuffer, m_WordSize);
 }
 
 ByteString CPDF_SyntaxParser::PeekNextWord(bool* bIsNumber) {
@@ -503,22 +507,23 @@ RetainPtr<CPDF_Object> CPDF_SyntaxParser::GetObjectBodyInternal(
 
   FX_FILESIZE SavedObjPos = m_Pos;
   bool bIsNumber;
-  ByteString word = GetNextWord(&bIsNumber);
+  ByteStringView word = GetNextWordView(&bIsNumber);
   if (word.IsEmpty())
     return nullptr;
 
   if (bIsNumber) {
+    // Reading ahead reuses |m_WordBuffer|, so keep a copy of the number.
+    ByteString number(word);
     AutoRestorer<FX_FILESIZE> pos_restorer(&m_Pos);
-    ByteString nextword = GetNextWord(&bIsNumber);
+    GetNextWordView(&bIsNumber);
     if (!bIsNumber)
-      return pdfium::MakeRetain<CPDF_Number>(word.AsStringView());
+      return pdfium::MakeRetain<CPDF_Number>(number.AsStringView());
 
-    ByteString nextword2 = GetNextWord(nullptr);
-    if (nextword2 != "R")
-      return pdfium::MakeRetain<CPDF_Number>(word.AsStringView());
+    if (GetNextWordView(nullptr) != "R")
+      return pdfium::MakeRetain<CPDF_Number>(number.AsStringView());
 
     pos_restorer.AbandonRestoration();
-    uint32_t refnum = FXSYS_atoui(word.c_str());
+    uint32_t refnum = FXSYS_atoui(number.c_str());
     if (refnum == CPDF_Object::kInvalidObjNum)
       return nullptr;
 
@@ -555,10 +560,9 @@ RetainPtr<CPDF_Object> CPDF_SyntaxParser::GetObjectBodyInternal(
         PDF_NameDecode(ByteStringView(m_WordBuffer + 1, m_WordSize - 1)));
   }
   if (word == "<<") {
-    RetainPtr<CPDF_Dictionary> pDict =
-        pdfium::MakeRetain<CPDF_Dictionary>(m_pPool);
+    std::vector<CPDF_Dictionary::Entry> entries;
     while (1) {
-      ByteString inner_word = GetNextWord(nullptr);
+      ByteStringView inner_word = GetNextWordView(nullptr);
       if (inner_word.IsEmpty())
         return nullptr;
 
@@ -573,9 +577,8 @@ RetainPtr<CPDF_Object> CPDF_SyntaxParser::GetObjectBodyInternal(
       if (inner_word[0] != '/')
         continue;
 
-      ByteString key = PDF_NameDecode(inner_word.AsStringView());
-      if (key.IsEmpty() && parse_type == ParseType::kLoose)
-        continue;
+      ByteString key =
+          PDF_NameDecode(inner_word.Last(inner_word.GetLength() - 1));
 
       RetainPtr<CPDF_Object> pObj =
           GetObjectBodyInternal(pObjList, ParseType::kLoose);
@@ -587,12 +590,22 @@ RetainPtr<CPDF_Object> CPDF_SyntaxParser::GetObjectBodyInternal(
         return nullptr;
       }
 
-      if (!key.IsEmpty()) {
-        ByteString keyNoSlash(key.raw_str() + 1, key.GetLength() - 1);
-        pDict->SetFor(keyNoSlash, std::move(pObj));
-      }
+      entries.emplace_back(std::move(key), std::move(pObj));
     }
 
+    // Insert in key order so that building the dictionary stays O(n log n)
+    // however the file orders its keys. The sort is stable, so the last of
+    // several duplicate keys still wins.
+    std::stable_sort(entries.begin(), entries.end(),
+                     [](const CPDF_Dictionary::Entry& lhs,
+                        const CPDF_Dictionary::Entry& rhs) {
+                       return lhs.first < rhs.first;
+                     });
+    RetainPtr<CPDF_Dictionary> pDict =
+        pdfium::MakeRetain<CPDF_Dictionary>(m_pPool);
+    for (auto& entry : entries)
+      pDict->SetFor(entry.first, std::move(entry.second));
+
     AutoRestorer<FX_FILESIZE> pos_restorer(&m_Pos);
     if (GetNextWord(nullptr) != "stream")
       return pDict;
@@ -625,7 +638,7 @@ RetainPtr<CPDF_Object> CPDF_SyntaxParser::GetIndirectObject(
   }
   const uint32_t parser_gennum = FXSYS_atoui(word.c_str());
 
-  if (GetKeyword() != "obj") {
+  if (GetNextWordView(nullptr) != "obj") {
     SetPos(saved_pos);
     return nullptr;
   }
@@ -59,6 +59,9 @@ class CPDF_SyntaxParser {
   bool ReadBlock(uint8_t* pBuf, uint32_t size);
   bool GetCharAt(FX_FILESIZE pos, uint8_t& ch);
   ByteString GetNextWord(bool* bIsNumber);
+  // Same as GetNextWord(), but returns a view of the parser's word buffer that
+  // is only valid until the next word is read.
+  ByteStringView GetNextWordView(bool* bIsNumber);
   ByteString PeekNextWord(bool* bIsNumber);
 
   const RetainPtr<CPDF_ReadValidator>& GetValidator() const {
@@ -18,6 +18,8 @@
 #include "core/fxcrt/fx_extension.h"
 #include "core/fxcrt/fx_stream.h"
 #include "base/logging.h"
+#include "base/no_destructor.h"
+#include "base/stl_util.h"
 
 // Indexed by 8-bit character code, contains either:
 //   'W' - for whitespace: NUL, TAB, CR, LF, FF, SPACE, 0x80, 0xff
@@ -85,12 +87,96 @@ Optional<FX_FILESIZE> GetHeaderOffset(
   return {};
 }
 
+namespace {
+
+// Names common enough that every document would otherwise allocate, hash and
+// intern its own copy of each, many times over.
+const char* const kNameAtoms[] = {
+    "A", "AA", "AIS", "AP", "AS", "Alternate", "Annot", "Annots", "Ascent",
+    "AvgWidth", "BBox", "BC", "BG", "BM", "BS", "BaseEncoding", "BaseFont",
+    "BitsPerComponent", "BitsPerCoordinate", "BitsPerFlag", "BitsPerSample",
+    "Border", "Bounds", "C", "C0", "C1", "CA", "CIDSystemInfo", "CIDToGIDMap",
+    "CS", "CapHeight", "Catalog", "CharProcs", "CharSet", "ColorSpace",
+    "Colors", "Columns", "Contents", "Count", "CropBox", "D", "DA", "DR", "DW",
+    "DW2", "Decode", "DecodeParms", "DescendantFonts", "Descent", "Dest",
+    "Dests", "DeviceCMYK", "DeviceGray", "DeviceRGB", "Differences", "Domain",
+    "E", "Encode", "Encoding", "Encrypt", "ExtGState", "Extend", "F", "FT",
+    "Ff", "Fields", "Filter", "First", "FirstChar", "Flags", "FlateDecode",
+    "Font", "FontBBox", "FontDescriptor", "FontFile", "FontFile2", "FontFile3",
+    "FontMatrix", "FontName", "Form", "FormType", "Function", "FunctionType",
+    "Functions", "Group", "H", "Height", "I", "ID", "ImageMask", "Index",
+    "Info", "Interpolate", "ItalicAngle", "K", "Kids", "L", "LC", "LJ", "LW",
+    "Lang", "Last", "LastChar", "Leading", "Length", "Length1", "Length2",
+    "Length3", "Limits", "Link", "Mask", "Matrix", "MaxWidth", "MediaBox",
+    "MissingWidth", "N", "Names", "Next", "NumCount", "Nums", "O", "OC",
+    "OCProperties", "OP", "OPM", "Off", "Opt", "Ordering", "Outlines", "P",
+    "Page", "PageLabels", "PageMode", "Pages", "Parent", "Pattern",
+    "PatternType", "Predictor", "Prev", "ProcSet", "Properties", "Q", "R",
+    "Range", "Rect", "Registry", "Resources", "Root", "Rotate", "S", "SA", "SM",
+    "SMask", "Shading", "ShadingType", "Size", "StemH", "StemV",
+    "StructParents", "Subtype", "Supplement", "T", "TK", "TR", "TU", "Text",
+    "Title", "ToUnicode", "TrimBox", "TrueType", "Type", "Type0", "Type1",
+    "Type3", "URI", "UserUnit", "V", "W", "W2", "Widget", "Width", "Widths",
+    "WinAnsiEncoding", "XObject", "XRef", "XRefStm",
+};
+
+// Open-addressed hash table over |kNameAtoms|. Filled once and never
+// modified afterwards.
+class NameAtomTable {
+ public:
+  NameAtomTable() {
+    for (uint16_t i = 0; i < pdfium::size(kNameAtoms); ++i) {
+      m_Atoms[i] = ByteString(kNameAtoms[i]);
+      size_t bucket = Hash(m_Atoms[i].AsStringView());
+      while (m_Buckets[bucket])
+        bucket = (bucket + 1) % kBucketCount;
+      m_Buckets[bucket] = i + 1;
+    }
+  }
+
+  const ByteString* Find(ByteStringView name) const {
+    for (size_t bucket = Hash(name); m_Buckets[bucket];
+         bucket = (bucket + 1) % kBucketCount) {
+      const ByteString& atom = m_Atoms[m_Buckets[bucket] - 1];
+      if (atom == name)
+        return &atom;
+    }
+    return nullptr;
+  }
+
+ private:
+  // Power of two, and at least twice the number of atoms.
+  static constexpr size_t kBucketCount = 512;
+  static_assert(pdfium::size(kNameAtoms) * 2 <= kBucketCount,
+                "too many name atoms");
+
+  static size_t Hash(ByteStringView name) {
+    return FX_HashCode_GetA(name, false) % kBucketCount;
+  }
+
+  ByteString m_Atoms[pdfium::size(kNameAtoms)];
+  // One plus the index into |m_Atoms|, or 0 for an empty bucket.
+  uint16_t m_Buckets[kBucketCount] = {};
+};
+
+}  // namespace
+
 int32_t GetDirectInteger(const CPDF_Dictionary* pDict, const ByteString& key) {
   const CPDF_Number* pObj = ToNumber(pDict->GetObjectFor(key));
   return pObj ? pObj->GetInteger() : 0;
 }
 
+const ByteString* PDF_FindNameAtom(ByteStringView name) {
+  static const pdfium::base::NoDestructor<NameAtomTable> table;
+  return table->Find(name);
+}
+
 ByteString PDF_NameDecode(ByteStringView orig) {
+  if (!orig.Contains('#')) {
+    const ByteString* atom = PDF_FindNameAtom(orig);
+    return atom ? *atom : ByteString(orig);
+  }
+
   size_t src_size = orig.GetLength();
   size_t out_index = 0;
   ByteString result;
@@ -48,6 +48,13 @@ Optional<FX_FILESIZE> GetHeaderOffset(
 
 int32_t GetDirectInteger(const CPDF_Dictionary* pDict, const ByteString& key);
 
+// Returns the process-wide shared copy of |name| if it is one of the common
+// PDF names, such as "Type" or "Resources", or nullptr otherwise. Like the
+// rest of PDFium, this is not thread-safe: the shared strings are reference
+// counted without atomics.
+const ByteString* PDF_FindNameAtom(ByteStringView name);
+
+// Decoded names that are common PDF names share their process-wide copy.
 ByteString PDF_NameDecode(ByteStringView orig);
 ByteString PDF_NameEncode(const ByteString& orig);
 
@@ -35,6 +35,7 @@ class CPDF_RenderOptions {
     bool bNoImageSmooth = false;
     bool bLimitedImageCache = false;
     bool bConvertFillToStroke = false;
+    bool bSimplifyPaths = false;
   };
 
   struct ColorScheme {
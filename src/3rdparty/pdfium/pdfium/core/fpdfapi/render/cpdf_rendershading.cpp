@@ -17,6 +17,7 @@
 #include "core/fpdfapi/page/cpdf_dib.h"
 #include "core/fpdfapi/page/cpdf_function.h"
 #include "core/fpdfapi/page/cpdf_meshstream.h"
+#include "core/fpdfapi/page/cpdf_shadingpattern.h"
 #include "core/fpdfapi/parser/cpdf_array.h"
 #include "core/fpdfapi/parser/cpdf_dictionary.h"
 #include "core/fpdfapi/parser/cpdf_stream.h"
@@ -53,16 +54,27 @@ uint32_t GetValidatedOutputsCount(
   return funcs_outputs ? std::max(funcs_outputs, pCS->CountComponents()) : 0;
 }
 
-std::array<FX_ARGB, kShadingSteps> GetShadingSteps(
+// Returns the color table of |pPattern| for |alpha|, building it and caching
+// it with the pattern on first use.
+const CPDF_ShadingPattern::ColorTable& GetShadingSteps(
+    const CPDF_ShadingPattern* pPattern,
     float t_min,
     float t_max,
-    const std::vector<std::unique_ptr<CPDF_Function>>& funcs,
-    const RetainPtr<CPDF_ColorSpace>& pCS,
     int alpha,
     size_t results_count) {
+  static_assert(std::tuple_size<CPDF_ShadingPattern::ColorTable>::value ==
+                    kShadingSteps,
+                "Color table must have one entry per shading step");
+  const CPDF_ShadingPattern::ColorTable* pCached =
+      pPattern->GetColorTable(alpha);
+  if (pCached)
+    return *pCached;
+
+  const auto& funcs = pPattern->GetFuncs();
+  RetainPtr<CPDF_ColorSpace> pCS = pPattern->GetCS();
   ASSERT(results_count >= CountOutputsFromFunctions(funcs));
   ASSERT(results_count >= pCS->CountComponents());
-  std::array<FX_ARGB, kShadingSteps> shading_steps;
+  CPDF_ShadingPattern::ColorTable shading_steps;
   std::vector<float> result_array(results_count);
   float diff = t_max - t_min;
   for (int i = 0; i < kShadingSteps; ++i) {
@@ -83,21 +95,21 @@ std::array<FX_ARGB, kShadingSteps> GetShadingSteps(
         FXARGB_TODIB(ArgbEncode(alpha, FXSYS_roundf(R * 255),
                                 FXSYS_roundf(G * 255), FXSYS_roundf(B * 255)));
   }
-  return shading_steps;
+  return pPattern->SetColorTable(alpha, shading_steps);
 }
 
 void DrawAxialShading(const RetainPtr<CFX_DIBitmap>& pBitmap,
                       const CFX_Matrix& mtObject2Bitmap,
-                      const CPDF_Dictionary* pDict,
-                      const std::vector<std::unique_ptr<CPDF_Function>>& funcs,
-                      const RetainPtr<CPDF_ColorSpace>& pCS,
+                      const CPDF_ShadingPattern* pPattern,
                       int alpha) {
   ASSERT(pBitmap->GetFormat() == FXDIB_Argb);
 
-  const uint32_t total_results = GetValidatedOutputsCount(funcs, pCS);
+  const uint32_t total_results =
+      GetValidatedOutputsCount(pPattern->GetFuncs(), pPattern->GetCS());
   if (total_results == 0)
     return;
 
+  const CPDF_Dictionary* pDict = pPattern->GetShadingObject()->GetDict();
   const CPDF_Array* pCoords = pDict->GetArrayFor("Coords");
   if (!pCoords)
     return;
@@ -123,21 +135,29 @@ void DrawAxialShading(const RetainPtr<CFX_DIBitmap>& pBitmap,
   float y_span = end_y - start_y;
   float axis_len_square = (x_span * x_span) + (y_span * y_span);
 
-  std::array<FX_ARGB, kShadingSteps> shading_steps =
-      GetShadingSteps(t_min, t_max, funcs, pCS, alpha, total_results);
+  const CPDF_ShadingPattern::ColorTable& shading_steps =
+      GetShadingSteps(pPattern, t_min, t_max, alpha, total_results);
 
   int pitch = pBitmap->GetPitch();
   CFX_Matrix matrix = mtObject2Bitmap.GetInverse();
+  std::vector<int32_t> indices(width);
   for (int row = 0; row < height; row++) {
-    uint32_t* dib_buf =
-        reinterpret_cast<uint32_t*>(pBitmap->GetBuffer() + row * pitch);
+    // Map the row in a separate, branch-free pass the compiler can vectorize.
+    // It evaluates the same expressions as CFX_Matrix::Transform().
+    const float row_x = matrix.c * static_cast<float>(row);
+    const float row_y = matrix.d * static_cast<float>(row);
     for (int column = 0; column < width; column++) {
-      CFX_PointF pos = matrix.Transform(
-          CFX_PointF(static_cast<float>(column), static_cast<float>(row)));
+      float pos_x = matrix.a * static_cast<float>(column) + row_x + matrix.e;
+      float pos_y = matrix.b * static_cast<float>(column) + row_y + matrix.f;
       float scale =
-          (((pos.x - start_x) * x_span) + ((pos.y - start_y) * y_span)) /
+          (((pos_x - start_x) * x_span) + ((pos_y - start_y) * y_span)) /
           axis_len_square;
-      int index = (int32_t)(scale * (kShadingSteps - 1));
+      indices[column] = static_cast<int32_t>(scale * (kShadingSteps - 1));
+    }
+    uint32_t* dib_buf =
+        reinterpret_cast<uint32_t*>(pBitmap->GetBuffer() + row * pitch);
+    for (int column = 0; column < width; column++) {
+      int index = indices[column];
       if (index < 0) {
         if (!bStartExtend)
           continue;
@@ -156,16 +176,16 @@ void DrawAxialShading(const RetainPtr<CFX_DIBitmap>& pBitmap,
 
 void DrawRadialShading(const RetainPtr<CFX_DIBitmap>& pBitmap,
                        const CFX_Matrix& mtObject2Bitmap,
-                       const CPDF_Dictionary* pDict,
-                       const std::vector<std::unique_ptr<CPDF_Function>>& funcs,
-                       const RetainPtr<CPDF_ColorSpace>& pCS,
+                       const CPDF_ShadingPattern* pPattern,
                        int alpha) {
   ASSERT(pBitmap->GetFormat() == FXDIB_Argb);
 
-  const uint32_t total_results = GetValidatedOutputsCount(funcs, pCS);
+  const uint32_t total_results =
+      GetValidatedOutputsCount(pPattern->GetFuncs(), pPattern->GetCS());
   if (total_results == 0)
     return;
 
+  const CPDF_Dictionary* pDict = pPattern->GetShadingObject()->GetDict();
   const CPDF_Array* pCoords = pDict->GetArrayFor("Coords");
   if (!pCoords)
     return;
@@ -187,8 +207,8 @@ void DrawRadialShading(const RetainPtr<CFX_DIBitmap>& pBitmap,
   const bool bStartExtend = pArray && pArray->GetBooleanAt(0, false);
   const bool bEndExtend = pArray && pArray->GetBooleanAt(1, false);
 
-  std::array<FX_ARGB, kShadingSteps> shading_steps =
-      GetShadingSteps(t_min, t_max, funcs, pCS, alpha, total_results);
+  const CPDF_ShadingPattern::ColorTable& shading_steps =
+      GetShadingSteps(pPattern, t_min, t_max, alpha, total_results);
 
   const float dx = end_x - start_x;
   const float dy = end_y - start_y;
@@ -207,11 +227,14 @@ void DrawRadialShading(const RetainPtr<CFX_DIBitmap>& pBitmap,
   for (int row = 0; row < height; row++) {
     uint32_t* dib_buf =
         reinterpret_cast<uint32_t*>(pBitmap->GetBuffer() + row * pitch);
+    // Same expressions as CFX_Matrix::Transform(), with the row terms hoisted.
+    const float row_x = matrix.c * static_cast<float>(row);
+    const float row_y = matrix.d * static_cast<float>(row);
     for (int column = 0; column < width; column++) {
-      CFX_PointF pos = matrix.Transform(
-          CFX_PointF(static_cast<float>(column), static_cast<float>(row)));
-      float pos_dx = pos.x - start_x;
-      float pos_dy = pos.y - start_y;
+      float pos_dx =
+          matrix.a * static_cast<float>(column) + row_x + matrix.e - start_x;
+      float pos_dy =
+          matrix.b * static_cast<float>(column) + row_y + matrix.f - start_y;
       float b = -2 * (pos_dx * dx + pos_dy * dy + start_r * dr);
       float c = pos_dx * pos_dx + pos_dy * pos_dy - start_r * start_r;
       float s;
@@ -909,10 +932,10 @@ void CPDF_RenderShading::Draw(CFX_RenderDevice* pDevice,
       DrawFuncShading(pBitmap, FinalMatrix, pDict, funcs, pColorSpace, alpha);
       break;
     case kAxialShading:
-      DrawAxialShading(pBitmap, FinalMatrix, pDict, funcs, pColorSpace, alpha);
+      DrawAxialShading(pBitmap, FinalMatrix, pPattern, alpha);
       break;
     case kRadialShading:
-      DrawRadialShading(pBitmap, FinalMatrix, pDict, funcs, pColorSpace, alpha);
+      DrawRadialShading(pBitmap, FinalMatrix, pPattern, alpha);
       break;
     case kFreeFormGouraudTriangleMeshShading: {
       // The shading object can be a stream or a dictionary. We do not handle
@@ -123,6 +123,119 @@ bool IsAvailableMatrix(const CFX_Matrix& matrix) {
   return true;
 }
 
+// Level-of-detail thresholds, in device pixels, used when
+// CPDF_RenderOptions::Options::bSimplifyPaths is set.
+constexpr float kMinVisiblePathExtent = 0.5f;
+constexpr float kPathFlatnessTolerance = 0.1f;
+// Paths with fewer points are drawn as-is; copying them costs more than
+// rasterizing the few segments simplification could drop.
+constexpr size_t kMinSimplifiablePathPoints = 8;
+// Caps how many consecutive vertices one merged segment may replace, which
+// keeps the collinearity check linear in the path size.
+constexpr size_t kMaxMergedPathVertices = 32;
+
+float DistanceToSegmentSquared(const CFX_PointF& point,
+                               const CFX_PointF& start,
+                               const CFX_PointF& end) {
+  float dx = end.x - start.x;
+  float dy = end.y - start.y;
+  float px = point.x - start.x;
+  float py = point.y - start.y;
+  float length_squared = dx * dx + dy * dy;
+  if (length_squared > 0) {
+    float t = std::min(std::max((px * dx + py * dy) / length_squared, 0.0f),
+                       1.0f);
+    px -= t * dx;
+    py -= t * dy;
+  }
+  return px * px + py * py;
+}
+
+// Returns a copy of |path| without the vertices that move its outline under
+// |matrix| by less than kPathFlatnessTolerance: runs of nearly collinear line
+// segments are merged, and Beziers whose control points lie on their chord
+// become lines. Points stay in the path's own space so that stroke widths are
+// still transformed by the caller's matrix.
+CFX_PathData SimplifyPathForDevice(const CFX_PathData& path,
+                                   const CFX_Matrix& matrix) {
+  constexpr float kToleranceSquared =
+      kPathFlatnessTolerance * kPathFlatnessTolerance;
+  const std::vector<FX_PATHPOINT>& points = path.GetPoints();
+  CFX_PathData result;
+  std::vector<FX_PATHPOINT>& out = result.GetPoints();
+  out.reserve(points.size());
+
+  // |anchor| is the device position of the last point written to |out|.
+  // |held| has the device positions of the line vertices after it that may
+  // still be merged away; |pending| is the last of them.
+  CFX_PointF anchor;
+  CFX_PointF current;
+  std::vector<CFX_PointF> held;
+  Optional<FX_PATHPOINT> pending;
+  auto flush = [&]() {
+    if (held.empty())
+      return;
+    out.push_back(pending.value());
+    anchor = held.back();
+    held.clear();
+  };
+  auto add_line = [&](const FX_PATHPOINT& point, const CFX_PointF& device) {
+    if (!held.empty()) {
+      bool mergeable = held.size() < kMaxMergedPathVertices;
+      for (size_t j = 0; mergeable && j < held.size(); ++j) {
+        mergeable =
+            DistanceToSegmentSquared(held[j], anchor, device) <=
+            kToleranceSquared;
+      }
+      if (!mergeable)
+        flush();
+    }
+    pending.emplace(point);
+    held.push_back(device);
+    if (point.m_CloseFigure)
+      flush();
+  };
+
+  for (size_t i = 0; i < points.size(); ++i) {
+    const FX_PATHPOINT& point = points[i];
+    CFX_PointF device = matrix.Transform(point.m_Point);
+    if (i == 0 || point.m_Type == FXPT_TYPE::MoveTo) {
+      flush();
+      out.push_back(point);
+      anchor = device;
+    } else if (point.m_Type == FXPT_TYPE::LineTo) {
+      add_line(point, device);
+    } else if (i + 2 >= points.size()) {
+      // Truncated Bezier; keep it for the driver to handle as before.
+      flush();
+      out.insert(out.end(), points.begin() + i, points.end());
+      return result;
+    } else {
+      CFX_PointF control2 = matrix.Transform(points[i + 1].m_Point);
+      CFX_PointF end = matrix.Transform(points[i + 2].m_Point);
+      bool flat = !point.m_CloseFigure && !points[i + 1].m_CloseFigure &&
+                  DistanceToSegmentSquared(device, current, end) <=
+                      kToleranceSquared &&
+                  DistanceToSegmentSquared(control2, current, end) <=
+                      kToleranceSquared;
+      if (flat) {
+        FX_PATHPOINT line = points[i + 2];
+        line.m_Type = FXPT_TYPE::LineTo;
+        add_line(line, end);
+      } else {
+        flush();
+        out.insert(out.end(), points.begin() + i, points.begin() + i + 3);
+        anchor = end;
+      }
+      device = end;
+      i += 2;
+    }
+    current = device;
+  }
+  flush();
+  return result;
+}
+
 bool MissingFillColor(const CPDF_ColorState* pColorState) {
   return !pColorState->HasRef() || pColorState->GetFillColor()->IsNull();
 }
@@ -422,8 +535,22 @@ bool CPDF_RenderStatus::ProcessPath(CPDF_PathObject* path_obj,
   if (!IsAvailableMatrix(path_matrix))
     return true;
 
+  const CFX_PathData* path_data = path_obj->path().GetObject();
+  Optional<CFX_PathData> simplified_path;
+  if (options.bSimplifyPaths) {
+    CFX_FloatRect device_rect = mtObj2Device.TransformRect(path_obj->GetRect());
+    if (device_rect.Width() < kMinVisiblePathExtent &&
+        device_rect.Height() < kMinVisiblePathExtent) {
+      return true;
+    }
+    if (path_data->GetPoints().size() >= kMinSimplifiablePathPoints) {
+      simplified_path.emplace(SimplifyPathForDevice(*path_data, path_matrix));
+      path_data = &simplified_path.value();
+    }
+  }
+
   return m_pDevice->DrawPathWithBlend(
-      path_obj->path().GetObject(), &path_matrix,
+      path_data, &path_matrix,
       path_obj->m_GraphState.GetObject(), fill_argb, stroke_argb,
       GetFillOptionsForDrawPathWithBlend(options, path_obj, fill_type, stroke,
                                          m_pType3Char),
@@ -510,6 +637,22 @@ void CPDF_RenderStatus::ProcessClipPath(const CPDF_ClipPath& ClipPath,
 
   m_LastClipPath = ClipPath;
   m_pDevice->RestoreState(true);
+  if (ClipPath.GetPathCount() > 1) {
+    // Nothing outside the intersection of the paths' bounding boxes survives
+    // the clip, so clip to it first. This keeps the masks the device builds
+    // for the paths below to the area that can still be drawn, instead of
+    // e.g. a whole slide for each object in a framed slide.
+    FX_RECT clip_box = m_pDevice->GetClipBox();
+    for (size_t i = 0; i < ClipPath.GetPathCount(); ++i) {
+      const CFX_PathData* pPathData = ClipPath.GetPath(i).GetObject();
+      if (pPathData && !pPathData->GetPoints().empty()) {
+        clip_box.Intersect(
+            mtObj2Device.TransformRect(pPathData->GetBoundingBox())
+                .GetOuterRect());
+      }
+    }
+    m_pDevice->SetClip_Rect(clip_box);
+  }
   for (size_t i = 0; i < ClipPath.GetPathCount(); ++i) {
     const CFX_PathData* pPathData = ClipPath.GetPath(i).GetObject();
     if (!pPathData)
@@ -6,10 +6,15 @@
 
 #include "core/fpdfapi/render/cpdf_rendertiling.h"
 
+#include <string.h>
+
+#include <array>
 #include <limits>
 #include <memory>
 
+#include "core/fpdfapi/page/cpdf_docpagedata.h"
 #include "core/fpdfapi/page/cpdf_form.h"
+#include "core/fpdfapi/page/cpdf_pageobject.h"
 #include "core/fpdfapi/page/cpdf_tilingpattern.h"
 #include "core/fpdfapi/parser/cpdf_document.h"
 #include "core/fpdfapi/render/cpdf_pagerendercache.h"
@@ -18,6 +23,7 @@
 #include "core/fpdfapi/render/cpdf_renderstatus.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxge/cfx_defaultrenderdevice.h"
+#include "base/stl_util.h"
 
 namespace {
 
@@ -63,6 +69,81 @@ RetainPtr<CFX_DIBitmap> DrawPatternBitmap(
   return pBitmap;
 }
 
+RetainPtr<CFX_DIBitmap> DrawPatternCell(CPDF_RenderContext* pContext,
+                                        CPDF_TilingPattern* pPattern,
+                                        CPDF_Form* pPatternForm,
+                                        const CFX_Matrix& mtObj2Device,
+                                        int width,
+                                        int height,
+                                        const CPDF_RenderOptions& options) {
+  RetainPtr<CFX_DIBitmap> pPatternBitmap;
+  if (width * height < 16) {
+    RetainPtr<CFX_DIBitmap> pEnlargedBitmap = DrawPatternBitmap(
+        pContext->GetDocument(), pContext->GetPageCache(), pPattern,
+        pPatternForm, mtObj2Device, 8, 8, options.GetOptions());
+    pPatternBitmap = pEnlargedBitmap->StretchTo(
+        width, height, FXDIB_ResampleOptions(), nullptr);
+  } else {
+    pPatternBitmap = DrawPatternBitmap(
+        pContext->GetDocument(), pContext->GetPageCache(), pPattern,
+        pPatternForm, mtObj2Device, width, height, options.GetOptions());
+  }
+  if (!pPatternBitmap)
+    return nullptr;
+
+  if (options.ColorModeIs(CPDF_RenderOptions::kGray))
+    pPatternBitmap->ConvertColorScale(0, 0xffffff);
+  return pPatternBitmap;
+}
+
+// Returns the key under which a cell of |width| x |height| is cached for its
+// pattern, or an empty string if the cell must not be shared. Besides the
+// device matrix, size and options, the cell depends on the graphics state its
+// content inherits from |pPageObj|. Soft masks and transfer functions are not
+// captured by the key, so fills using them are drawn uncached.
+ByteString GetCellCacheKey(const CPDF_PageObject* pPageObj,
+                           const CFX_Matrix& mtObj2Device,
+                           int width,
+                           int height,
+                           const CPDF_RenderOptions& options) {
+  const CPDF_GeneralState& state = pPageObj->m_GeneralState;
+  if (state.GetSoftMask() || state.GetTR())
+    return ByteString();
+
+  const CPDF_RenderOptions::Options& draw_options = options.GetOptions();
+  const bool flags[] = {draw_options.bClearType,
+                        draw_options.bNoNativeText,
+                        draw_options.bForceHalftone,
+                        draw_options.bRectAA,
+                        draw_options.bBreakForMasks,
+                        draw_options.bNoTextSmooth,
+                        draw_options.bNoPathSmooth,
+                        draw_options.bNoImageSmooth,
+                        draw_options.bLimitedImageCache,
+                        draw_options.bConvertFillToStroke,
+                        draw_options.bSimplifyPaths,
+                        options.ColorModeIs(CPDF_RenderOptions::kGray),
+                        state.GetStrokeAdjust()};
+  uint32_t flag_bits = 0;
+  for (size_t i = 0; i < pdfium::size(flags); ++i)
+    flag_bits |= static_cast<uint32_t>(flags[i]) << i;
+
+  // The matrix is compared exactly so a cached cell is pixel-identical to one
+  // rendered afresh.
+  const float values[] = {mtObj2Device.a,      mtObj2Device.b,
+                          mtObj2Device.c,      mtObj2Device.d,
+                          mtObj2Device.e,      mtObj2Device.f,
+                          state.GetFillAlpha(), state.GetStrokeAlpha()};
+  std::array<uint32_t, pdfium::size(values) + 4> key;
+  memcpy(key.data(), values, sizeof(values));
+  key[pdfium::size(values)] = width;
+  key[pdfium::size(values) + 1] = height;
+  key[pdfium::size(values) + 2] = static_cast<uint32_t>(state.GetBlendType());
+  key[pdfium::size(values) + 3] = flag_bits;
+  return ByteString(reinterpret_cast<const char*>(key.data()),
+                    key.size() * sizeof(uint32_t));
+}
+
 }  // namespace
 
 // static
@@ -167,23 +248,22 @@ RetainPtr<CFX_DIBitmap> CPDF_RenderTiling::Draw(
   }
   float left_offset = cell_bbox.left - mtPattern2Device.e;
   float top_offset = cell_bbox.bottom - mtPattern2Device.f;
+  CPDF_DocPageData* pPageData =
+      CPDF_DocPageData::FromDocument(pPattern->document());
+  const ByteString cell_key =
+      GetCellCacheKey(pPageObj, mtObj2Device, width, height, options);
   RetainPtr<CFX_DIBitmap> pPatternBitmap;
-  if (width * height < 16) {
-    RetainPtr<CFX_DIBitmap> pEnlargedBitmap = DrawPatternBitmap(
-        pContext->GetDocument(), pContext->GetPageCache(), pPattern,
-        pPatternForm, mtObj2Device, 8, 8, options.GetOptions());
-    pPatternBitmap = pEnlargedBitmap->StretchTo(
-        width, height, FXDIB_ResampleOptions(), nullptr);
-  } else {
-    pPatternBitmap = DrawPatternBitmap(
-        pContext->GetDocument(), pContext->GetPageCache(), pPattern,
-        pPatternForm, mtObj2Device, width, height, options.GetOptions());
-  }
-  if (!pPatternBitmap)
-    return nullptr;
+  if (!cell_key.IsEmpty())
+    pPatternBitmap = pPageData->GetTilingCell(pPattern, cell_key);
+  if (!pPatternBitmap) {
+    pPatternBitmap = DrawPatternCell(pContext, pPattern, pPatternForm,
+                                     mtObj2Device, width, height, options);
+    if (!pPatternBitmap)
+      return nullptr;
 
-  if (options.ColorModeIs(CPDF_RenderOptions::kGray))
-    pPatternBitmap->ConvertColorScale(0, 0xffffff);
+    if (!cell_key.IsEmpty())
+      pPageData->CacheTilingCell(pPattern, cell_key, pPatternBitmap);
+  }
 
   FX_ARGB fill_argb = pRenderStatus->GetFillArgb(pPageObj);
   int clip_width = clip_box.right - clip_box.left;
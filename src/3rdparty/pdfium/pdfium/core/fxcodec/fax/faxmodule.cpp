@@ -43,6 +43,32 @@ constexpr int kFaxMaxImageDimension = 65535;
 constexpr int kFaxBpc = 1;
 constexpr int kFaxComps = 1;
 
+// Reads 8 bytes as a big-endian word, so bit 63 is the first pixel.
+uint64_t LoadPixelWord(const uint8_t* buf) {
+  return (static_cast<uint64_t>(buf[0]) << 56) |
+         (static_cast<uint64_t>(buf[1]) << 48) |
+         (static_cast<uint64_t>(buf[2]) << 40) |
+         (static_cast<uint64_t>(buf[3]) << 32) |
+         (static_cast<uint64_t>(buf[4]) << 24) |
+         (static_cast<uint64_t>(buf[5]) << 16) |
+         (static_cast<uint64_t>(buf[6]) << 8) | static_cast<uint64_t>(buf[7]);
+}
+
+// Returns the number of leading zero bits in |word|, which must be non-zero.
+int CountLeadingZeros(uint64_t word) {
+  ASSERT(word);
+#if defined(COMPILER_GCC)
+  return __builtin_clzll(word);
+#else
+  int count = 0;
+  while (!(word >> 56)) {
+    word <<= 8;
+    count += 8;
+  }
+  return count + OneLeadPos[word >> 56];
+#endif
+}
+
 int FindBit(const uint8_t* data_buf, int max_pos, int start_pos, bool bit) {
   ASSERT(start_pos >= 0);
   if (start_pos >= max_pos)
@@ -62,18 +88,14 @@ int FindBit(const uint8_t* data_buf, int max_pos, int start_pos, bool bit) {
   const int max_byte = (max_pos + 7) / 8;
   int byte_pos = start_pos / 8;
 
-  // Try reading in bigger chunks in case there are long runs to be skipped.
-  static constexpr int kBulkReadSize = 8;
-  if (max_byte >= kBulkReadSize && byte_pos < max_byte - kBulkReadSize) {
-    static constexpr uint8_t skip_block_0[kBulkReadSize] = {
-        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
-    static constexpr uint8_t skip_block_1[kBulkReadSize] = {
-        0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff};
-    const uint8_t* skip_block = bit ? skip_block_0 : skip_block_1;
-    while (byte_pos < max_byte - kBulkReadSize &&
-           memcmp(data_buf + byte_pos, skip_block, kBulkReadSize) == 0) {
-      byte_pos += kBulkReadSize;
-    }
+  // Scan a word at a time, so long runs cost one compare per 64 pixels.
+  const uint64_t word_xor = bit ? 0 : ~static_cast<uint64_t>(0);
+  while (byte_pos + 8 <= max_byte) {
+    uint64_t data = LoadPixelWord(data_buf + byte_pos) ^ word_xor;
+    if (data)
+      return std::min(byte_pos * 8 + CountLeadingZeros(data), max_pos);
+
+    byte_pos += 8;
   }
 
   while (byte_pos < max_byte) {
@@ -115,19 +137,19 @@ void FaxFillBits(uint8_t* dest_buf, int columns, int startpos, int endpos) {
   if (startpos >= endpos)
     return;
 
+  // Pixels start out white (1) and runs never overlap, so clearing the bits
+  // is enough.
   int first_byte = startpos / 8;
   int last_byte = (endpos - 1) / 8;
+  uint8_t first_mask = 0xff >> (startpos % 8);
+  uint8_t last_mask = 0xff << (7 - (endpos - 1) % 8);
   if (first_byte == last_byte) {
-    for (int i = startpos % 8; i <= (endpos - 1) % 8; ++i)
-      dest_buf[first_byte] -= 1 << (7 - i);
+    dest_buf[first_byte] &= ~(first_mask & last_mask);
     return;
   }
 
-  for (int i = startpos % 8; i < 8; ++i)
-    dest_buf[first_byte] -= 1 << (7 - i);
-  for (int i = 0; i <= (endpos - 1) % 8; ++i)
-    dest_buf[last_byte] -= 1 << (7 - i);
-
+  dest_buf[first_byte] &= ~first_mask;
+  dest_buf[last_byte] &= ~last_mask;
   if (last_byte > first_byte + 1)
     memset(dest_buf + first_byte + 1, 0, last_byte - first_byte - 1);
 }
@@ -252,31 +274,95 @@ const uint8_t FaxWhiteRunIns[] = {
     0xff,
 };
 
-int FaxGetRun(const uint8_t* ins_array,
-              const uint8_t* src_buf,
-              int* bitpos,
-              int bitsize) {
-  uint32_t code = 0;
-  int ins_off = 0;
-  while (1) {
-    uint8_t ins = ins_array[ins_off++];
-    if (ins == 0xff)
-      return -1;
+// Code lookup table built from one of the instruction arrays above. Each of
+// those lists, per code length starting at 1 bit, the number of codes of that
+// length followed by (code, run length low byte, run length high byte)
+// triples, and ends with 0xff.
+class FaxRunTable {
+ public:
+  explicit FaxRunTable(const uint8_t* ins_array) {
+    std::fill(std::begin(m_Entries), std::end(m_Entries), 0);
+    int ins_off = 0;
+    m_LongestCode = 0;
+    while (ins_array[ins_off] != 0xff) {
+      const int code_bits = ++m_LongestCode;
+      ASSERT(code_bits <= kMaxCodeBits);
+      const int count = ins_array[ins_off++];
+      for (int i = 0; i < count; ++i, ins_off += 3) {
+        uint32_t code = ins_array[ins_off];
+        if (code >> code_bits)
+          continue;
+
+        uint16_t run = ins_array[ins_off + 1] + ins_array[ins_off + 2] * 256;
+        ASSERT(run <= kRunMask);
+        uint32_t first = code << (kMaxCodeBits - code_bits);
+        uint32_t last = first + (1 << (kMaxCodeBits - code_bits));
+        for (uint32_t index = first; index < last; ++index) {
+          if (!m_Entries[index])
+            m_Entries[index] = (code_bits << kCodeBitsShift) | run;
+        }
+      }
+    }
+  }
 
+  // Decodes one code at |*bitpos|. Returns -1 and skips as many bits as a
+  // bit-serial search through every code length would, when no code matches
+  // before the end of the input.
+  int GetRun(const uint8_t* src_buf, int* bitpos, int bitsize) const {
     if (*bitpos >= bitsize)
       return -1;
 
-    code <<= 1;
-    if (src_buf[*bitpos / 8] & (1 << (7 - *bitpos % 8)))
-      ++code;
+    uint32_t bits = PeekBits(src_buf, *bitpos, bitsize) >>
+                    (32 - kMaxCodeBits);
+    uint16_t entry = m_Entries[bits];
+    int code_bits = entry >> kCodeBitsShift;
+    if (code_bits == 0 || code_bits > bitsize - *bitpos) {
+      *bitpos = std::min(*bitpos + m_LongestCode, bitsize);
+      return -1;
+    }
+    *bitpos += code_bits;
+    return entry & kRunMask;
+  }
 
-    ++(*bitpos);
-    int next_off = ins_off + ins * 3;
-    for (; ins_off < next_off; ins_off += 3) {
-      if (ins_array[ins_off] == code)
-        return ins_array[ins_off + 1] + ins_array[ins_off + 2] * 256;
+ private:
+  static constexpr int kMaxCodeBits = 13;
+  static constexpr int kCodeBitsShift = 12;
+  static constexpr uint16_t kRunMask = (1 << kCodeBitsShift) - 1;
+
+  // Returns the 32 bits at |bitpos|, MSB first, with zeros past the input.
+  static uint32_t PeekBits(const uint8_t* src_buf, int bitpos, int bitsize) {
+    const int byte_pos = bitpos / 8;
+    const int byte_size = (bitsize + 7) / 8;
+    const uint8_t* p = src_buf + byte_pos;
+    if (byte_pos + 4 <= byte_size) {
+      return ((static_cast<uint32_t>(p[0]) << 24) | (p[1] << 16) |
+              (p[2] << 8) | p[3])
+             << (bitpos % 8);
+    }
+    uint32_t word = 0;
+    for (int i = 0; i < 4; ++i) {
+      word <<= 8;
+      if (byte_pos + i < byte_size)
+        word |= p[i];
     }
+    return word << (bitpos % 8);
   }
+
+  // Length of the longest code, in bits.
+  int m_LongestCode;
+  // Code length in the top 4 bits, run length in the rest. 0 if no code
+  // matches.
+  uint16_t m_Entries[1 << kMaxCodeBits];
+};
+
+const FaxRunTable& GetFaxRunTable(bool white) {
+  static const FaxRunTable kWhiteRunTable(FaxWhiteRunIns);
+  static const FaxRunTable kBlackRunTable(FaxBlackRunIns);
+  return white ? kWhiteRunTable : kBlackRunTable;
+}
+
+int FaxGetRun(bool white, const uint8_t* src_buf, int* bitpos, int bitsize) {
+  return GetFaxRunTable(white).GetRun(src_buf, bitpos, bitsize);
 }
 
 void FaxG4GetRow(const uint8_t* src_buf,
@@ -312,8 +398,7 @@ void FaxG4GetRow(const uint8_t* src_buf,
       } else if (bit2) {
         int run_len1 = 0;
         while (1) {
-          int run = FaxGetRun(a0color ? FaxWhiteRunIns : FaxBlackRunIns,
-                              src_buf, bitpos, bitsize);
+          int run = FaxGetRun(a0color, src_buf, bitpos, bitsize);
           run_len1 += run;
           if (run < 64)
             break;
@@ -329,8 +414,7 @@ void FaxG4GetRow(const uint8_t* src_buf,
 
         int run_len2 = 0;
         while (1) {
-          int run = FaxGetRun(a0color ? FaxBlackRunIns : FaxWhiteRunIns,
-                              src_buf, bitpos, bitsize);
+          int run = FaxGetRun(!a0color, src_buf, bitpos, bitsize);
           run_len2 += run;
           if (run < 64)
             break;
@@ -429,8 +513,7 @@ void FaxGet1DLine(const uint8_t* src_buf,
 
     int run_len = 0;
     while (1) {
-      int run = FaxGetRun(color ? FaxWhiteRunIns : FaxBlackRunIns, src_buf,
-                          bitpos, bitsize);
+      int run = FaxGetRun(color, src_buf, bitpos, bitsize);
       if (run < 0) {
         while (*bitpos < bitsize) {
           if (NextBit(src_buf, bitpos))
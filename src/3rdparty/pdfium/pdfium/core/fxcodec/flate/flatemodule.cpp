@@ -284,6 +284,98 @@ uint8_t PathPredictor(int a, int b, int c) {
   return (uint8_t)c;
 }
 
+// Row kernels for the PNG filter types. |raw| holds the filtered bytes without
+// the tag byte, and |last| is the previous decoded row, or null for the first
+// row. |dest| may alias |raw| as long as it does not start after it. Bytes
+// without a left neighbour are handled before the main loop so the loops below
+// carry no per-byte branches.
+void PNG_PredictSub(uint8_t* dest,
+                    const uint8_t* raw,
+                    uint32_t size,
+                    uint32_t bpp) {
+  uint32_t byte = 0;
+  for (; byte < std::min(bpp, size); ++byte)
+    dest[byte] = raw[byte];
+  for (; byte < size; ++byte)
+    dest[byte] = raw[byte] + dest[byte - bpp];
+}
+
+void PNG_PredictUp(uint8_t* dest,
+                   const uint8_t* raw,
+                   const uint8_t* last,
+                   uint32_t size) {
+  if (!last) {
+    memmove(dest, raw, size);
+    return;
+  }
+  for (uint32_t byte = 0; byte < size; ++byte)
+    dest[byte] = raw[byte] + last[byte];
+}
+
+void PNG_PredictAverage(uint8_t* dest,
+                        const uint8_t* raw,
+                        const uint8_t* last,
+                        uint32_t size,
+                        uint32_t bpp) {
+  uint32_t byte = 0;
+  if (!last) {
+    for (; byte < std::min(bpp, size); ++byte)
+      dest[byte] = raw[byte];
+    for (; byte < size; ++byte)
+      dest[byte] = raw[byte] + dest[byte - bpp] / 2;
+    return;
+  }
+  for (; byte < std::min(bpp, size); ++byte)
+    dest[byte] = raw[byte] + last[byte] / 2;
+  for (; byte < size; ++byte)
+    dest[byte] = raw[byte] + (dest[byte - bpp] + last[byte]) / 2;
+}
+
+void PNG_PredictPaeth(uint8_t* dest,
+                      const uint8_t* raw,
+                      const uint8_t* last,
+                      uint32_t size,
+                      uint32_t bpp) {
+  // With no row above, the Paeth predictor always picks the left byte.
+  if (!last) {
+    PNG_PredictSub(dest, raw, size, bpp);
+    return;
+  }
+  uint32_t byte = 0;
+  for (; byte < std::min(bpp, size); ++byte)
+    dest[byte] = raw[byte] + last[byte];
+  for (; byte < size; ++byte) {
+    dest[byte] = raw[byte] + PathPredictor(dest[byte - bpp], last[byte],
+                                           last[byte - bpp]);
+  }
+}
+
+// Decodes |size| bytes of one row filtered with |tag|.
+void PNG_PredictRow(uint8_t tag,
+                    uint8_t* dest,
+                    const uint8_t* raw,
+                    const uint8_t* last,
+                    uint32_t size,
+                    uint32_t bpp) {
+  switch (tag) {
+    case 1:
+      PNG_PredictSub(dest, raw, size, bpp);
+      break;
+    case 2:
+      PNG_PredictUp(dest, raw, last, size);
+      break;
+    case 3:
+      PNG_PredictAverage(dest, raw, last, size, bpp);
+      break;
+    case 4:
+      PNG_PredictPaeth(dest, raw, last, size, bpp);
+      break;
+    default:
+      memmove(dest, raw, size);
+      break;
+  }
+}
+
 void PNG_PredictLine(uint8_t* pDestData,
                      const uint8_t* pSrcData,
                      const uint8_t* pLastLine,
@@ -292,65 +384,13 @@ void PNG_PredictLine(uint8_t* pDestData,
                      int nPixels) {
   const uint32_t row_size = CalculatePitch8(bpc, nColors, nPixels).ValueOrDie();
   const uint32_t BytesPerPixel = (bpc * nColors + 7) / 8;
-  uint8_t tag = pSrcData[0];
-  if (tag == 0) {
-    memmove(pDestData, pSrcData + 1, row_size);
-    return;
-  }
-  for (uint32_t byte = 0; byte < row_size; ++byte) {
-    uint8_t raw_byte = pSrcData[byte + 1];
-    switch (tag) {
-      case 1: {
-        uint8_t left = 0;
-        if (byte >= BytesPerPixel) {
-          left = pDestData[byte - BytesPerPixel];
-        }
-        pDestData[byte] = raw_byte + left;
-        break;
-      }
-      case 2: {
-        uint8_t up = 0;
-        if (pLastLine) {
-          up = pLastLine[byte];
-        }
-        pDestData[byte] = raw_byte + up;
-        break;
-      }
-      case 3: {
-        uint8_t left = 0;
-        if (byte >= BytesPerPixel) {
-          left = pDestData[byte - BytesPerPixel];
-        }
-        uint8_t up = 0;
-        if (pLastLine) {
-          up = pLastLine[byte];
-        }
-        pDestData[byte] = raw_byte + (up + left) / 2;
-        break;
-      }
-      case 4: {
-        uint8_t left = 0;
-        if (byte >= BytesPerPixel) {
-          left = pDestData[byte - BytesPerPixel];
-        }
-        uint8_t up = 0;
-        if (pLastLine) {
-          up = pLastLine[byte];
-        }
-        uint8_t upper_left = 0;
-        if (byte >= BytesPerPixel && pLastLine) {
-          upper_left = pLastLine[byte - BytesPerPixel];
-        }
-        pDestData[byte] = raw_byte + PathPredictor(left, up, upper_left);
-        break;
-      }
-      default:
-        pDestData[byte] = raw_byte;
-        break;
-    }
-  }
+  PNG_PredictRow(pSrcData[0], pDestData, pSrcData + 1, pLastLine, row_size,
+                 BytesPerPixel);
 }
 
+// Undoes the PNG row filters in place. Each decoded row is written at or
+// before the start of its own encoded bytes (one tag byte per earlier row has
+// been dropped), so no second buffer of the whole image is needed.
 bool PNG_Predictor(int Colors,
                    int BitsPerComponent,
                    int Columns,
@@ -365,11 +405,9 @@ bool PNG_Predictor(int Colors,
   if (row_count <= 0)
     return false;
   const int last_row_size = *data_size % (row_size + 1);
-  std::unique_ptr<uint8_t, FxFreeDeleter> dest_buf(
-      FX_Alloc2D(uint8_t, row_size, row_count));
   uint32_t byte_cnt = 0;
-  uint8_t* pSrcData = data_buf->get();
-  uint8_t* pDestData = dest_buf.get();
+  const uint8_t* pSrcData = data_buf->get();
+  uint8_t* pDestData = data_buf->get();
   for (int row = 0; row < row_count; row++) {
     uint8_t tag = pSrcData[0];
     byte_cnt++;
@@ -378,69 +416,19 @@ bool PNG_Predictor(int Colors,
       if ((row + 1) * (move_size + 1) > static_cast<int>(*data_size)) {
         move_size = last_row_size - 1;
       }
-      memcpy(pDestData, pSrcData + 1, move_size);
+      memmove(pDestData, pSrcData + 1, move_size);
       pSrcData += move_size + 1;
       pDestData += move_size;
       byte_cnt += move_size;
       continue;
     }
-    for (int byte = 0; byte < row_size && byte_cnt < *data_size;
-         ++byte, ++byte_cnt) {
-      uint8_t raw_byte = pSrcData[byte + 1];
-      switch (tag) {
-        case 1: {
-          uint8_t left = 0;
-          if (byte >= BytesPerPixel) {
-            left = pDestData[byte - BytesPerPixel];
-          }
-          pDestData[byte] = raw_byte + left;
-          break;
-        }
-        case 2: {
-          uint8_t up = 0;
-          if (row) {
-            up = pDestData[byte - row_size];
-          }
-          pDestData[byte] = raw_byte + up;
-          break;
-        }
-        case 3: {
-          uint8_t left = 0;
-          if (byte >= BytesPerPixel) {
-            left = pDestData[byte - BytesPerPixel];
-          }
-          uint8_t up = 0;
-          if (row) {
-            up = pDestData[byte - row_size];
-          }
-          pDestData[byte] = raw_byte + (up + left) / 2;
-          break;
-        }
-        case 4: {
-          uint8_t left = 0;
-          if (byte >= BytesPerPixel) {
-            left = pDestData[byte - BytesPerPixel];
-          }
-          uint8_t up = 0;
-          if (row) {
-            up = pDestData[byte - row_size];
-          }
-          uint8_t upper_left = 0;
-          if (byte >= BytesPerPixel && row) {
-            upper_left = pDestData[byte - row_size - BytesPerPixel];
-          }
-          pDestData[byte] = raw_byte + PathPredictor(left, up, upper_left);
-          break;
-        }
-        default:
-          pDestData[byte] = raw_byte;
-          break;
-      }
-    }
+    const uint32_t size = std::min<uint32_t>(row_size, *data_size - byte_cnt);
+    PNG_PredictRow(tag, pDestData, pSrcData + 1,
+                   row ? pDestData - row_size : nullptr, size, BytesPerPixel);
+    byte_cnt += size;
     pSrcData += row_size + 1;
     pDestData += row_size;
   }
-  *data_buf = std::move(dest_buf);
   *data_size = row_size * row_count -
                (last_row_size > 0 ? (row_size + 1 - last_row_size) : 0);
   return true;
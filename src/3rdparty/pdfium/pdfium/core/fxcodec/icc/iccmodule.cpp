@@ -49,8 +49,34 @@ CLcmsCmm::~CLcmsCmm() {
   cmsDeleteTransform(m_hTransform);
 }
 
+pdfium::span<const uint8_t> CLcmsCmm::GetLookupTable() {
+  ASSERT(!m_bLab);
+  ASSERT(m_nSrcComponents == 1 || m_nSrcComponents == 3);
+  if (!m_LookupTable.empty())
+    return m_LookupTable;
+
+  constexpr int kLevels = IccModule::kLookupLevels;
+  const int nEntries = m_nSrcComponents == 1 ? 256 : kLevels * kLevels * kLevels;
+  std::vector<uint8_t, FxAllocAllocator<uint8_t>> inputs(nEntries *
+                                                         m_nSrcComponents);
+  if (m_nSrcComponents == 1) {
+    for (int i = 0; i < nEntries; ++i)
+      inputs[i] = static_cast<uint8_t>(i);
+  } else {
+    size_t src_index = 0;
+    for (int i = 0; i < nEntries; ++i) {
+      inputs[src_index++] = static_cast<uint8_t>(i / (kLevels * kLevels) * 5);
+      inputs[src_index++] = static_cast<uint8_t>(i / kLevels % kLevels * 5);
+      inputs[src_index++] = static_cast<uint8_t>(i % kLevels * 5);
+    }
+  }
+  m_LookupTable.resize(nEntries * 3);
+  cmsDoTransform(m_hTransform, inputs.data(), m_LookupTable.data(), nEntries);
+  return m_LookupTable;
+}
+
 // static
-std::unique_ptr<CLcmsCmm> IccModule::CreateTransformSRGB(
+RetainPtr<CLcmsCmm> IccModule::CreateTransformSRGB(
     pdfium::span<const uint8_t> span) {
   ScopedCmsProfile srcProfile(cmsOpenProfileFromMem(span.data(), span.size()));
   if (!srcProfile)
@@ -104,7 +130,8 @@ std::unique_ptr<CLcmsCmm> IccModule::CreateTransformSRGB(
   if (!hTransform)
     return nullptr;
 
-  return std::make_unique<CLcmsCmm>(hTransform, nSrcComponents, bLab, bNormal);
+  return pdfium::MakeRetain<CLcmsCmm>(hTransform, nSrcComponents, bLab,
+                                      bNormal);
 }
 
 // static
@@ -119,19 +146,23 @@ void IccModule::Translate(CLcmsCmm* pTransform,
   // TODO(npm): Currently the CmsDoTransform method is part of LCMS and it will
   // apply some member of m_hTransform to the input. We need to go over all the
   // places which set transform to verify that only |nSrcComponents| are used.
+  constexpr uint32_t kMaxInputs = 16;
+  const uint32_t nInputs = std::min(nSrcComponents, kMaxInputs);
   if (pTransform->IsLab()) {
-    std::vector<double> inputs(std::max(nSrcComponents, 16u));
-    for (uint32_t i = 0; i < nSrcComponents; ++i)
+    double inputs[kMaxInputs] = {};
+    for (uint32_t i = 0; i < nInputs; ++i)
       inputs[i] = pSrcValues[i];
-    cmsDoTransform(pTransform->transform(), inputs.data(), output, 1);
+    cmsDoTransform(pTransform->transform(), inputs, output, 1);
   } else {
-    std::vector<uint8_t, FxAllocAllocator<uint8_t>> inputs(
-        std::max(nSrcComponents, 16u));
-    for (uint32_t i = 0; i < nSrcComponents; ++i) {
+    uint8_t inputs[kMaxInputs] = {};
+    for (uint32_t i = 0; i < nInputs; ++i) {
       inputs[i] =
           pdfium::clamp(static_cast<int>(pSrcValues[i] * 255.0f), 0, 255);
     }
-    cmsDoTransform(pTransform->transform(), inputs.data(), output, 1);
+    if (pTransform->components() == 1 && nSrcComponents == 1)
+      TranslateScanlineWithLookupTable(pTransform, output, inputs, 1);
+    else
+      cmsDoTransform(pTransform->transform(), inputs, output, 1);
   }
   pDestValues[0] = output[2] / 255.0f;
   pDestValues[1] = output[1] / 255.0f;
@@ -147,4 +178,30 @@ void IccModule::TranslateScanline(CLcmsCmm* pTransform,
     cmsDoTransform(pTransform->transform(), pSrc, pDest, pixels);
 }
 
+// static
+void IccModule::TranslateScanlineWithLookupTable(CLcmsCmm* pTransform,
+                                                 uint8_t* pDest,
+                                                 const uint8_t* pSrc,
+                                                 int pixels) {
+  pdfium::span<const uint8_t> table = pTransform->GetLookupTable();
+  if (pTransform->components() == 1) {
+    for (int i = 0; i < pixels; ++i) {
+      const uint8_t* bgr = &table[pSrc[i] * 3];
+      *pDest++ = bgr[0];
+      *pDest++ = bgr[1];
+      *pDest++ = bgr[2];
+    }
+    return;
+  }
+  for (int i = 0; i < pixels; ++i) {
+    int index = (pSrc[0] / 5 * kLookupLevels + pSrc[1] / 5) * kLookupLevels +
+                pSrc[2] / 5;
+    pSrc += 3;
+    const uint8_t* bgr = &table[index * 3];
+    *pDest++ = bgr[0];
+    *pDest++ = bgr[1];
+    *pDest++ = bgr[2];
+  }
+}
+
 }  // namespace fxcodec
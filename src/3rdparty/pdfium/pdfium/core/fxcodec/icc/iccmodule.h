@@ -9,38 +9,53 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
 
 #include "core/fxcodec/fx_codec_def.h"
+#include "core/fxcrt/fx_memory_wrappers.h"
 #include "core/fxcrt/fx_system.h"
+#include "core/fxcrt/retain_ptr.h"
 #include "base/span.h"
 
 #include <lcms2.h>
 
 namespace fxcodec {
 
-class CLcmsCmm {
+class CLcmsCmm final : public Retainable {
  public:
-  CLcmsCmm(cmsHTRANSFORM transform,
-           int srcComponents,
-           bool bIsLab,
-           bool bNormal);
-  ~CLcmsCmm();
+  CONSTRUCT_VIA_MAKE_RETAIN;
 
   cmsHTRANSFORM transform() const { return m_hTransform; }
   int components() const { return m_nSrcComponents; }
   bool IsLab() const { return m_bLab; }
   bool IsNormal() const { return m_bNormal; }
 
+  // BGR results for every 8-bit input of a 1-component transform, or for the
+  // 52-level grid of a 3-component one. Built on first use and then shared by
+  // every color space using this transform.
+  pdfium::span<const uint8_t> GetLookupTable();
+
  private:
+  CLcmsCmm(cmsHTRANSFORM transform,
+           int srcComponents,
+           bool bIsLab,
+           bool bNormal);
+  ~CLcmsCmm() override;
+
   const cmsHTRANSFORM m_hTransform;
   const int m_nSrcComponents;
   const bool m_bLab;
   const bool m_bNormal;
+  std::vector<uint8_t, FxAllocAllocator<uint8_t>> m_LookupTable;
 };
 
 class IccModule {
  public:
-  static std::unique_ptr<CLcmsCmm> CreateTransformSRGB(
+  // Number of levels per component in the lookup table of a 3-component
+  // transform. Inputs are quantized to multiples of 5.
+  static constexpr int kLookupLevels = 52;
+
+  static RetainPtr<CLcmsCmm> CreateTransformSRGB(
       pdfium::span<const uint8_t> span);
   static void Translate(CLcmsCmm* pTransform,
                         uint32_t nSrcComponents,
@@ -50,6 +65,12 @@ class IccModule {
                                 uint8_t* pDest,
                                 const uint8_t* pSrc,
                                 int pixels);
+  // Like TranslateScanline(), but through the lookup table of a 1- or
+  // 3-component, non-Lab transform. Exact for 1-component input.
+  static void TranslateScanlineWithLookupTable(CLcmsCmm* pTransform,
+                                               uint8_t* pDest,
+                                               const uint8_t* pSrc,
+                                               int pixels);
 
   IccModule() = delete;
   IccModule(const IccModule&) = delete;
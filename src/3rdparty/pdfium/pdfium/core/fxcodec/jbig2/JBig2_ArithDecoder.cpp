@@ -9,9 +9,8 @@
 #include "core/fxcodec/jbig2/JBig2_BitStream.h"
 #include "base/stl_util.h"
 
-namespace {
-
-const JBig2ArithCtx::JBig2ArithQe kQeTable[] = {
+// static
+const JBig2ArithCtx::JBig2ArithQe JBig2ArithCtx::kQeTable[] = {
     // Stupid hack to keep clang-format from reformatting this badly.
     {0x5601, 1, 1, true},    {0x3401, 2, 6, false},   {0x1801, 3, 9, false},
     {0x0AC1, 4, 12, false},  {0x0521, 5, 29, false},  {0x0221, 38, 33, false},
@@ -30,10 +29,6 @@ const JBig2ArithCtx::JBig2ArithQe kQeTable[] = {
     {0x0015, 43, 40, false}, {0x0009, 44, 41, false}, {0x0005, 45, 42, false},
     {0x0001, 45, 43, false}, {0x5601, 46, 46, false}};
 
-const unsigned int kDefaultAValue = 0x8000;
-
-}  // namespace
-
 JBig2ArithCtx::JBig2ArithCtx() = default;
 
 int JBig2ArithCtx::DecodeNLPS(const JBig2ArithQe& qe) {
@@ -63,16 +58,13 @@ CJBig2_ArithDecoder::CJBig2_ArithDecoder(CJBig2_BitStream* pStream)
 
 CJBig2_ArithDecoder::~CJBig2_ArithDecoder() = default;
 
-int CJBig2_ArithDecoder::Decode(JBig2ArithCtx* pCX) {
+int CJBig2_ArithDecoder::DecodeSlow(JBig2ArithCtx* pCX) {
   ASSERT(pCX);
-  ASSERT(pCX->I() < pdfium::size(kQeTable));
+  ASSERT(pCX->I() < pdfium::size(JBig2ArithCtx::kQeTable));
 
-  const JBig2ArithCtx::JBig2ArithQe& qe = kQeTable[pCX->I()];
-  m_A -= qe.Qe;
+  // Decode() has already subtracted Qe from A.
+  const JBig2ArithCtx::JBig2ArithQe& qe = JBig2ArithCtx::kQeTable[pCX->I()];
   if ((m_C >> 16) < m_A) {
-    if (m_A & kDefaultAValue)
-      return pCX->MPS();
-
     const int D = m_A < qe.Qe ? pCX->DecodeNLPS(qe) : pCX->DecodeNMPS(qe);
     ReadValueA();
     return D;
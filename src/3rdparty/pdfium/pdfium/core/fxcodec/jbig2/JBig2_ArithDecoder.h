@@ -24,6 +24,8 @@ class JBig2ArithCtx {
     bool bSwitch;
   };
 
+  static const JBig2ArithQe kQeTable[47];
+
   JBig2ArithCtx();
 
   int DecodeNLPS(const JBig2ArithQe& qe);
@@ -31,6 +33,7 @@ class JBig2ArithCtx {
 
   unsigned int MPS() const { return m_MPS ? 1 : 0; }
   unsigned int I() const { return m_I; }
+  uint16_t Qe() const { return kQeTable[m_I].Qe; }
 
  private:
   bool m_MPS = 0;
@@ -42,7 +45,15 @@ class CJBig2_ArithDecoder {
   explicit CJBig2_ArithDecoder(CJBig2_BitStream* pStream);
   ~CJBig2_ArithDecoder();
 
-  int Decode(JBig2ArithCtx* pCX);
+  // Most decisions return the MPS without renormalizing; that path is inlined
+  // into the region decoders' per-pixel loops and everything else is left to
+  // DecodeSlow().
+  int Decode(JBig2ArithCtx* pCX) {
+    m_A -= pCX->Qe();
+    if ((m_C >> 16) < m_A && (m_A & kDefaultAValue))
+      return pCX->MPS();
+    return DecodeSlow(pCX);
+  }
 
   bool IsComplete() const { return m_Complete; }
 
@@ -53,6 +64,9 @@ class CJBig2_ArithDecoder {
     kLooping,
   };
 
+  static constexpr unsigned int kDefaultAValue = 0x8000;
+
+  int DecodeSlow(JBig2ArithCtx* pCX);
   void BYTEIN();
   void ReadValueA();
 
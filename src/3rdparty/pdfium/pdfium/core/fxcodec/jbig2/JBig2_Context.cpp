@@ -16,6 +16,7 @@
 
 #include "core/fxcodec/jbig2/JBig2_ArithDecoder.h"
 #include "core/fxcodec/jbig2/JBig2_BitStream.h"
+#include "core/fxcodec/jbig2/JBig2_DocumentContext.h"
 #include "core/fxcodec/jbig2/JBig2_GrdProc.h"
 #include "core/fxcodec/jbig2/JBig2_GrrdProc.h"
 #include "core/fxcodec/jbig2/JBig2_HtrdProc.h"
@@ -39,41 +40,30 @@ size_t GetRefAggContextSize(bool val) {
 
 }  // namespace
 
-// Implement a very small least recently used (LRU) cache. It is very
-// common for a JBIG2 dictionary to span multiple pages in a PDF file,
-// and we do not want to decode the same dictionary over and over
-// again. We key off of the memory location of the dictionary. The
-// list keeps track of the freshness of entries, with freshest ones
-// at the front. Even a tiny cache size like 2 makes a dramatic
-// difference for typical JBIG2 documents.
-static const size_t kSymbolDictCacheMaxSize = 2;
-static_assert(kSymbolDictCacheMaxSize > 0,
-              "Symbol Dictionary Cache must have non-zero size");
-
 // static
 std::unique_ptr<CJBig2_Context> CJBig2_Context::Create(
     pdfium::span<const uint8_t> pGlobalSpan,
     uint32_t dwGlobalObjNum,
     pdfium::span<const uint8_t> pSrcSpan,
     uint32_t dwSrcObjNum,
-    std::list<CJBig2_CachePair>* pSymbolDictCache) {
+    JBig2_DocumentContext* pDocumentContext) {
   auto result = pdfium::WrapUnique(
-      new CJBig2_Context(pSrcSpan, dwSrcObjNum, pSymbolDictCache, false));
+      new CJBig2_Context(pSrcSpan, dwSrcObjNum, pDocumentContext, false));
   if (!pGlobalSpan.empty()) {
     result->m_pGlobalContext = pdfium::WrapUnique(new CJBig2_Context(
-        pGlobalSpan, dwGlobalObjNum, pSymbolDictCache, true));
+        pGlobalSpan, dwGlobalObjNum, pDocumentContext, true));
   }
   return result;
 }
 
 CJBig2_Context::CJBig2_Context(pdfium::span<const uint8_t> pSrcSpan,
                                uint32_t dwObjNum,
-                               std::list<CJBig2_CachePair>* pSymbolDictCache,
+                               JBig2_DocumentContext* pDocumentContext,
                                bool bIsGlobal)
     : m_pStream(std::make_unique<CJBig2_BitStream>(pSrcSpan, dwObjNum)),
       m_HuffmanTables(CJBig2_HuffmanTable::kNumHuffmanTables),
       m_bIsGlobal(bIsGlobal),
-      m_pSymbolDictCache(pSymbolDictCache) {}
+      m_pDocumentContext(pDocumentContext) {}
 
 CJBig2_Context::~CJBig2_Context() = default;
 
@@ -516,22 +506,13 @@ JBig2_Result CJBig2_Context::ParseSymbolDict(CJBig2_Segment* pSegment) {
 
   CJBig2_CacheKey key =
       CJBig2_CacheKey(pSegment->m_dwObjNum, pSegment->m_dwDataOffset);
-  bool cache_hit = false;
   pSegment->m_nResultType = JBIG2_SYMBOL_DICT_POINTER;
-  if (m_bIsGlobal && key.first != 0) {
-    for (auto it = m_pSymbolDictCache->begin(); it != m_pSymbolDictCache->end();
-         ++it) {
-      if (it->first == key) {
-        pSegment->m_SymbolDict = it->second->DeepCopy();
-        m_pSymbolDictCache->push_front(
-            CJBig2_CachePair(key, std::move(it->second)));
-        m_pSymbolDictCache->erase(it);
-        cache_hit = true;
-        break;
-      }
-    }
-  }
-  if (!cache_hit) {
+  // Symbol dictionaries in JBIG2Globals are usually shared by every page of
+  // the document, so the document context keeps decoded copies of them.
+  const bool bCacheable = m_bIsGlobal && key.first != 0;
+  if (bCacheable)
+    pSegment->m_SymbolDict = m_pDocumentContext->GetSymbolDict(key);
+  if (!pSegment->m_SymbolDict) {
     if (bUseGbContext) {
       auto pArithDecoder =
           std::make_unique<CJBig2_ArithDecoder>(m_pStream.get());
@@ -549,16 +530,8 @@ JBig2_Result CJBig2_Context::ParseSymbolDict(CJBig2_Segment* pSegment) {
         return JBig2_Result::kFailure;
       m_pStream->alignByte();
     }
-    if (m_bIsGlobal) {
-      std::unique_ptr<CJBig2_SymbolDict> value =
-          pSegment->m_SymbolDict->DeepCopy();
-      size_t size = m_pSymbolDictCache->size();
-      while (size >= kSymbolDictCacheMaxSize) {
-        m_pSymbolDictCache->pop_back();
-        --size;
-      }
-      m_pSymbolDictCache->push_front(CJBig2_CachePair(key, std::move(value)));
-    }
+    if (bCacheable)
+      m_pDocumentContext->AddSymbolDict(key, *pSegment->m_SymbolDict);
   }
   if (wFlags & 0x0200) {
     if (bUseGbContext)
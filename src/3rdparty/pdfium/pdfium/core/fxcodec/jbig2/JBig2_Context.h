@@ -8,7 +8,6 @@
 #define CORE_FXCODEC_JBIG2_JBIG2_CONTEXT_H_
 
 #include <cstdint>
-#include <list>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -17,18 +16,15 @@
 #include "core/fxcodec/jbig2/JBig2_Page.h"
 #include "core/fxcodec/jbig2/JBig2_Segment.h"
 #include "core/fxcrt/fx_safe_types.h"
+#include "core/fxcrt/unowned_ptr.h"
 #include "base/span.h"
 
 class CJBig2_ArithDecoder;
 class CJBig2_GRDProc;
 class CPDF_StreamAcc;
+class JBig2_DocumentContext;
 class PauseIndicatorIface;
 
-// Cache is keyed by the ObjNum of a stream and an index within the stream.
-using CJBig2_CacheKey = std::pair<uint32_t, uint32_t>;
-using CJBig2_CachePair =
-    std::pair<CJBig2_CacheKey, std::unique_ptr<CJBig2_SymbolDict>>;
-
 #define JBIG2_MIN_SEGMENT_SIZE 11
 
 enum class JBig2_Result { kSuccess, kFailure, kEndReached };
@@ -40,7 +36,7 @@ class CJBig2_Context {
       uint32_t dwGlobalObjNum,
       pdfium::span<const uint8_t> pSrcSpan,
       uint32_t dwSrcObjNum,
-      std::list<CJBig2_CachePair>* pSymbolDictCache);
+      JBig2_DocumentContext* pDocumentContext);
 
   ~CJBig2_Context();
 
@@ -58,7 +54,7 @@ class CJBig2_Context {
  private:
   CJBig2_Context(pdfium::span<const uint8_t> pSrcSpan,
                  uint32_t dwObjNum,
-                 std::list<CJBig2_CachePair>* pSymbolDictCache,
+                 JBig2_DocumentContext* pDocumentContext,
                  bool bIsGlobal);
 
   JBig2_Result DecodeSequential(PauseIndicatorIface* pPause);
@@ -104,7 +100,7 @@ class CJBig2_Context {
   std::unique_ptr<CJBig2_Segment> m_pSegment;
   FX_SAFE_UINT32 m_dwOffset = 0;
   JBig2RegionInfo m_ri;
-  std::list<CJBig2_CachePair>* const m_pSymbolDictCache;
+  UnownedPtr<JBig2_DocumentContext> const m_pDocumentContext;
 };
 
 #endif  // CORE_FXCODEC_JBIG2_JBIG2_CONTEXT_H_
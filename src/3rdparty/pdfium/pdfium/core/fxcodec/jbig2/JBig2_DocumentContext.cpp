@@ -9,6 +9,74 @@
 #include "core/fxcodec/jbig2/JBig2_Image.h"
 #include "core/fxcodec/jbig2/JBig2_SymbolDict.h"
 
+JBig2_DocumentContext::CacheEntry::CacheEntry(
+    const CJBig2_CacheKey& key,
+    std::unique_ptr<CJBig2_SymbolDict> dict,
+    size_t size)
+    : key(key), dict(std::move(dict)), size(size) {}
+
+JBig2_DocumentContext::CacheEntry::CacheEntry(CacheEntry&& that) = default;
+
+JBig2_DocumentContext::CacheEntry::~CacheEntry() = default;
+
 JBig2_DocumentContext::JBig2_DocumentContext() = default;
 
 JBig2_DocumentContext::~JBig2_DocumentContext() = default;
+
+std::unique_ptr<CJBig2_SymbolDict> JBig2_DocumentContext::GetSymbolDict(
+    const CJBig2_CacheKey& key) {
+  for (auto it = m_SymbolDictCache.begin(); it != m_SymbolDictCache.end();
+       ++it) {
+    if (it->key == key) {
+      m_SymbolDictCache.splice(m_SymbolDictCache.begin(), m_SymbolDictCache,
+                               it);
+      ++m_SymbolDictCacheHits;
+      return it->dict->DeepCopy();
+    }
+  }
+  ++m_SymbolDictCacheMisses;
+  return nullptr;
+}
+
+void JBig2_DocumentContext::AddSymbolDict(const CJBig2_CacheKey& key,
+                                          const CJBig2_SymbolDict& dict) {
+  if (m_SymbolDictCacheBudget == 0)
+    return;
+
+  for (auto it = m_SymbolDictCache.begin(); it != m_SymbolDictCache.end();
+       ++it) {
+    if (it->key == key) {
+      m_SymbolDictCacheBytes -= it->size;
+      m_SymbolDictCache.erase(it);
+      break;
+    }
+  }
+  size_t size = dict.GetMemorySize();
+  m_SymbolDictCache.emplace_front(key, dict.DeepCopy(), size);
+  m_SymbolDictCacheBytes += size;
+  EvictSymbolDicts();
+}
+
+void JBig2_DocumentContext::SetSymbolDictCacheBudget(size_t bytes) {
+  m_SymbolDictCacheBudget = bytes;
+  EvictSymbolDicts();
+}
+
+JBig2_DocumentContext::SymbolDictCacheStats
+JBig2_DocumentContext::GetSymbolDictCacheStats() const {
+  SymbolDictCacheStats stats;
+  stats.hits = m_SymbolDictCacheHits;
+  stats.misses = m_SymbolDictCacheMisses;
+  stats.entries = m_SymbolDictCache.size();
+  stats.bytes = m_SymbolDictCacheBytes;
+  return stats;
+}
+
+void JBig2_DocumentContext::EvictSymbolDicts() {
+  const size_t min_entries = m_SymbolDictCacheBudget ? 1 : 0;
+  while (m_SymbolDictCache.size() > min_entries &&
+         m_SymbolDictCacheBytes > m_SymbolDictCacheBudget) {
+    m_SymbolDictCacheBytes -= m_SymbolDictCache.back().size;
+    m_SymbolDictCache.pop_back();
+  }
+}
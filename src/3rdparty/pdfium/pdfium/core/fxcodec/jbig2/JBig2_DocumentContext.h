@@ -7,6 +7,8 @@
 #ifndef CORE_FXCODEC_JBIG2_JBIG2_DOCUMENTCONTEXT_H_
 #define CORE_FXCODEC_JBIG2_JBIG2_DOCUMENTCONTEXT_H_
 
+#include <stddef.h>
+
 #include <cstdint>
 #include <list>
 #include <memory>
@@ -14,22 +16,59 @@
 
 class CJBig2_SymbolDict;
 
+// Cache is keyed by the ObjNum of a stream and an index within the stream.
 using CJBig2_CacheKey = std::pair<uint32_t, uint32_t>;
-using CJBig2_CachePair =
-    std::pair<CJBig2_CacheKey, std::unique_ptr<CJBig2_SymbolDict>>;
 
 // Holds per-document JBig2 related data.
 class JBig2_DocumentContext {
  public:
+  struct SymbolDictCacheStats {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+  };
+
+  // Symbol dictionaries in JBIG2Globals streams are typically shared by every
+  // page of a scanned document, so keep decoded copies up to this many bytes.
+  static constexpr size_t kDefaultSymbolDictCacheBudget = 16 * 1024 * 1024;
+
   JBig2_DocumentContext();
   ~JBig2_DocumentContext();
 
-  std::list<CJBig2_CachePair>* GetSymbolDictCache() {
-    return &m_SymbolDictCache;
-  }
+  // Returns a copy of the cached dictionary for |key|, or nullptr on a miss.
+  std::unique_ptr<CJBig2_SymbolDict> GetSymbolDict(const CJBig2_CacheKey& key);
+
+  // Caches a copy of |dict|. Least recently used entries are evicted until
+  // the cache fits its budget, but the newest entry is kept even if it alone
+  // exceeds a non-zero budget. A budget of zero disables the cache.
+  void AddSymbolDict(const CJBig2_CacheKey& key, const CJBig2_SymbolDict& dict);
+
+  size_t GetSymbolDictCacheBudget() const { return m_SymbolDictCacheBudget; }
+  void SetSymbolDictCacheBudget(size_t bytes);
+  SymbolDictCacheStats GetSymbolDictCacheStats() const;
 
  private:
-  std::list<CJBig2_CachePair> m_SymbolDictCache;
+  struct CacheEntry {
+    CacheEntry(const CJBig2_CacheKey& key,
+               std::unique_ptr<CJBig2_SymbolDict> dict,
+               size_t size);
+    CacheEntry(CacheEntry&& that);
+    ~CacheEntry();
+
+    CJBig2_CacheKey key;
+    std::unique_ptr<CJBig2_SymbolDict> dict;
+    size_t size;
+  };
+
+  void EvictSymbolDicts();
+
+  // Freshest entries at the front.
+  std::list<CacheEntry> m_SymbolDictCache;
+  size_t m_SymbolDictCacheBudget = kDefaultSymbolDictCacheBudget;
+  size_t m_SymbolDictCacheBytes = 0;
+  size_t m_SymbolDictCacheHits = 0;
+  size_t m_SymbolDictCacheMisses = 0;
 };
 
 #endif  // CORE_FXCODEC_JBIG2_JBIG2_DOCUMENTCONTEXT_H_
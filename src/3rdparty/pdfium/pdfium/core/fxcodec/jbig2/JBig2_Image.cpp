@@ -41,6 +41,30 @@ int BitIndexToAlignedByte(int index) {
   return index / 32 * 4;
 }
 
+// |op| is a template parameter so the per-word switch folds away and the
+// compose loops below carry no branches besides their bounds checks.
+template <JBig2ComposeOp op>
+uint32_t ComposeWord(uint32_t src, uint32_t dst) {
+  switch (op) {
+    case JBIG2_COMPOSE_OR:
+      return src | dst;
+    case JBIG2_COMPOSE_AND:
+      return src & dst;
+    case JBIG2_COMPOSE_XOR:
+      return src ^ dst;
+    case JBIG2_COMPOSE_XNOR:
+      return ~(src ^ dst);
+    case JBIG2_COMPOSE_REPLACE:
+      return src;
+  }
+  return dst;
+}
+
+template <JBig2ComposeOp op>
+uint32_t ComposeWordMasked(uint32_t src, uint32_t dst, uint32_t mask) {
+  return (dst & ~mask) | (ComposeWord<op>(src, dst) & mask);
+}
+
 }  // namespace
 
 CJBig2_Image::CJBig2_Image(int32_t w, int32_t h) {
@@ -266,6 +290,26 @@ bool CJBig2_Image::ComposeToInternal(CJBig2_Image* pDst,
                                      int32_t y,
                                      JBig2ComposeOp op,
                                      const FX_RECT& rtSrc) {
+  switch (op) {
+    case JBIG2_COMPOSE_OR:
+      return ComposeToInternalForOp<JBIG2_COMPOSE_OR>(pDst, x, y, rtSrc);
+    case JBIG2_COMPOSE_AND:
+      return ComposeToInternalForOp<JBIG2_COMPOSE_AND>(pDst, x, y, rtSrc);
+    case JBIG2_COMPOSE_XOR:
+      return ComposeToInternalForOp<JBIG2_COMPOSE_XOR>(pDst, x, y, rtSrc);
+    case JBIG2_COMPOSE_XNOR:
+      return ComposeToInternalForOp<JBIG2_COMPOSE_XNOR>(pDst, x, y, rtSrc);
+    case JBIG2_COMPOSE_REPLACE:
+      return ComposeToInternalForOp<JBIG2_COMPOSE_REPLACE>(pDst, x, y, rtSrc);
+  }
+  return false;
+}
+
+template <JBig2ComposeOp op>
+bool CJBig2_Image::ComposeToInternalForOp(CJBig2_Image* pDst,
+                                          int32_t x,
+                                          int32_t y,
+                                          const FX_RECT& rtSrc) {
   ASSERT(m_pData);
 
   // TODO(weili): Check whether the range check is correct. Should x>=1048576?
@@ -322,24 +366,7 @@ bool CJBig2_Image::ComposeToInternal(CJBig2_Image* pDst,
             return false;
           uint32_t tmp1 = JBIG2_GETDWORD(lineSrc) << shift;
           uint32_t tmp2 = JBIG2_GETDWORD(lineDst);
-          uint32_t tmp = 0;
-          switch (op) {
-            case JBIG2_COMPOSE_OR:
-              tmp = (tmp2 & ~maskM) | ((tmp1 | tmp2) & maskM);
-              break;
-            case JBIG2_COMPOSE_AND:
-              tmp = (tmp2 & ~maskM) | ((tmp1 & tmp2) & maskM);
-              break;
-            case JBIG2_COMPOSE_XOR:
-              tmp = (tmp2 & ~maskM) | ((tmp1 ^ tmp2) & maskM);
-              break;
-            case JBIG2_COMPOSE_XNOR:
-              tmp = (tmp2 & ~maskM) | ((~(tmp1 ^ tmp2)) & maskM);
-              break;
-            case JBIG2_COMPOSE_REPLACE:
-              tmp = (tmp2 & ~maskM) | (tmp1 & maskM);
-              break;
-          }
+          uint32_t tmp = ComposeWordMasked<op>(tmp1, tmp2, maskM);
           JBIG2_PUTDWORD(lineDst, tmp);
           lineSrc += m_nStride;
           lineDst += pDst->m_nStride;
@@ -351,24 +378,7 @@ bool CJBig2_Image::ComposeToInternal(CJBig2_Image* pDst,
             return false;
           uint32_t tmp1 = JBIG2_GETDWORD(lineSrc) >> shift;
           uint32_t tmp2 = JBIG2_GETDWORD(lineDst);
-          uint32_t tmp = 0;
-          switch (op) {
-            case JBIG2_COMPOSE_OR:
-              tmp = (tmp2 & ~maskM) | ((tmp1 | tmp2) & maskM);
-              break;
-            case JBIG2_COMPOSE_AND:
-              tmp = (tmp2 & ~maskM) | ((tmp1 & tmp2) & maskM);
-              break;
-            case JBIG2_COMPOSE_XOR:
-              tmp = (tmp2 & ~maskM) | ((tmp1 ^ tmp2) & maskM);
-              break;
-            case JBIG2_COMPOSE_XNOR:
-              tmp = (tmp2 & ~maskM) | ((~(tmp1 ^ tmp2)) & maskM);
-              break;
-            case JBIG2_COMPOSE_REPLACE:
-              tmp = (tmp2 & ~maskM) | (tmp1 & maskM);
-              break;
-          }
+          uint32_t tmp = ComposeWordMasked<op>(tmp1, tmp2, maskM);
           JBIG2_PUTDWORD(lineDst, tmp);
           lineSrc += m_nStride;
           lineDst += pDst->m_nStride;
@@ -383,24 +393,7 @@ bool CJBig2_Image::ComposeToInternal(CJBig2_Image* pDst,
         uint32_t tmp1 = (JBIG2_GETDWORD(lineSrc) << shift1) |
                         (JBIG2_GETDWORD(lineSrc + 4) >> shift2);
         uint32_t tmp2 = JBIG2_GETDWORD(lineDst);
-        uint32_t tmp = 0;
-        switch (op) {
-          case JBIG2_COMPOSE_OR:
-            tmp = (tmp2 & ~maskM) | ((tmp1 | tmp2) & maskM);
-            break;
-          case JBIG2_COMPOSE_AND:
-            tmp = (tmp2 & ~maskM) | ((tmp1 & tmp2) & maskM);
-            break;
-          case JBIG2_COMPOSE_XOR:
-            tmp = (tmp2 & ~maskM) | ((tmp1 ^ tmp2) & maskM);
-            break;
-          case JBIG2_COMPOSE_XNOR:
-            tmp = (tmp2 & ~maskM) | ((~(tmp1 ^ tmp2)) & maskM);
-            break;
-          case JBIG2_COMPOSE_REPLACE:
-            tmp = (tmp2 & ~maskM) | (tmp1 & maskM);
-            break;
-        }
+        uint32_t tmp = ComposeWordMasked<op>(tmp1, tmp2, maskM);
         JBIG2_PUTDWORD(lineDst, tmp);
         lineSrc += m_nStride;
         lineDst += pDst->m_nStride;
@@ -420,24 +413,7 @@ bool CJBig2_Image::ComposeToInternal(CJBig2_Image* pDst,
           uint32_t tmp1 = (JBIG2_GETDWORD(sp) << shift1) |
                           (JBIG2_GETDWORD(sp + 4) >> shift2);
           uint32_t tmp2 = JBIG2_GETDWORD(dp);
-          uint32_t tmp = 0;
-          switch (op) {
-            case JBIG2_COMPOSE_OR:
-              tmp = (tmp2 & ~maskL) | ((tmp1 | tmp2) & maskL);
-              break;
-            case JBIG2_COMPOSE_AND:
-              tmp = (tmp2 & ~maskL) | ((tmp1 & tmp2) & maskL);
-              break;
-            case JBIG2_COMPOSE_XOR:
-              tmp = (tmp2 & ~maskL) | ((tmp1 ^ tmp2) & maskL);
-              break;
-            case JBIG2_COMPOSE_XNOR:
-              tmp = (tmp2 & ~maskL) | ((~(tmp1 ^ tmp2)) & maskL);
-              break;
-            case JBIG2_COMPOSE_REPLACE:
-              tmp = (tmp2 & ~maskL) | (tmp1 & maskL);
-              break;
-          }
+          uint32_t tmp = ComposeWordMasked<op>(tmp1, tmp2, maskL);
           JBIG2_PUTDWORD(dp, tmp);
           sp += 4;
           dp += 4;
@@ -446,24 +422,7 @@ bool CJBig2_Image::ComposeToInternal(CJBig2_Image* pDst,
           uint32_t tmp1 = (JBIG2_GETDWORD(sp) << shift1) |
                           (JBIG2_GETDWORD(sp + 4) >> shift2);
           uint32_t tmp2 = JBIG2_GETDWORD(dp);
-          uint32_t tmp = 0;
-          switch (op) {
-            case JBIG2_COMPOSE_OR:
-              tmp = tmp1 | tmp2;
-              break;
-            case JBIG2_COMPOSE_AND:
-              tmp = tmp1 & tmp2;
-              break;
-            case JBIG2_COMPOSE_XOR:
-              tmp = tmp1 ^ tmp2;
-              break;
-            case JBIG2_COMPOSE_XNOR:
-              tmp = ~(tmp1 ^ tmp2);
-              break;
-            case JBIG2_COMPOSE_REPLACE:
-              tmp = tmp1;
-              break;
-          }
+          uint32_t tmp = ComposeWord<op>(tmp1, tmp2);
           JBIG2_PUTDWORD(dp, tmp);
           sp += 4;
           dp += 4;
@@ -474,24 +433,7 @@ bool CJBig2_Image::ComposeToInternal(CJBig2_Image* pDst,
               (((sp + 4) < lineSrc + lineLeft ? JBIG2_GETDWORD(sp + 4) : 0) >>
                shift2);
           uint32_t tmp2 = JBIG2_GETDWORD(dp);
-          uint32_t tmp = 0;
-          switch (op) {
-            case JBIG2_COMPOSE_OR:
-              tmp = (tmp2 & ~maskR) | ((tmp1 | tmp2) & maskR);
-              break;
-            case JBIG2_COMPOSE_AND:
-              tmp = (tmp2 & ~maskR) | ((tmp1 & tmp2) & maskR);
-              break;
-            case JBIG2_COMPOSE_XOR:
-              tmp = (tmp2 & ~maskR) | ((tmp1 ^ tmp2) & maskR);
-              break;
-            case JBIG2_COMPOSE_XNOR:
-              tmp = (tmp2 & ~maskR) | ((~(tmp1 ^ tmp2)) & maskR);
-              break;
-            case JBIG2_COMPOSE_REPLACE:
-              tmp = (tmp2 & ~maskR) | (tmp1 & maskR);
-              break;
-          }
+          uint32_t tmp = ComposeWordMasked<op>(tmp1, tmp2, maskR);
           JBIG2_PUTDWORD(dp, tmp);
         }
         lineSrc += m_nStride;
@@ -507,24 +449,7 @@ bool CJBig2_Image::ComposeToInternal(CJBig2_Image* pDst,
         if (d1 != 0) {
           uint32_t tmp1 = JBIG2_GETDWORD(sp);
           uint32_t tmp2 = JBIG2_GETDWORD(dp);
-          uint32_t tmp = 0;
-          switch (op) {
-            case JBIG2_COMPOSE_OR:
-              tmp = (tmp2 & ~maskL) | ((tmp1 | tmp2) & maskL);
-              break;
-            case JBIG2_COMPOSE_AND:
-              tmp = (tmp2 & ~maskL) | ((tmp1 & tmp2) & maskL);
-              break;
-            case JBIG2_COMPOSE_XOR:
-              tmp = (tmp2 & ~maskL) | ((tmp1 ^ tmp2) & maskL);
-              break;
-            case JBIG2_COMPOSE_XNOR:
-              tmp = (tmp2 & ~maskL) | ((~(tmp1 ^ tmp2)) & maskL);
-              break;
-            case JBIG2_COMPOSE_REPLACE:
-              tmp = (tmp2 & ~maskL) | (tmp1 & maskL);
-              break;
-          }
+          uint32_t tmp = ComposeWordMasked<op>(tmp1, tmp2, maskL);
           JBIG2_PUTDWORD(dp, tmp);
           sp += 4;
           dp += 4;
@@ -532,24 +457,7 @@ bool CJBig2_Image::ComposeToInternal(CJBig2_Image* pDst,
         for (int32_t xx = 0; xx < middleDwords; xx++) {
           uint32_t tmp1 = JBIG2_GETDWORD(sp);
           uint32_t tmp2 = JBIG2_GETDWORD(dp);
-          uint32_t tmp = 0;
-          switch (op) {
-            case JBIG2_COMPOSE_OR:
-              tmp = tmp1 | tmp2;
-              break;
-            case JBIG2_COMPOSE_AND:
-              tmp = tmp1 & tmp2;
-              break;
-            case JBIG2_COMPOSE_XOR:
-              tmp = tmp1 ^ tmp2;
-              break;
-            case JBIG2_COMPOSE_XNOR:
-              tmp = ~(tmp1 ^ tmp2);
-              break;
-            case JBIG2_COMPOSE_REPLACE:
-              tmp = tmp1;
-              break;
-          }
+          uint32_t tmp = ComposeWord<op>(tmp1, tmp2);
           JBIG2_PUTDWORD(dp, tmp);
           sp += 4;
           dp += 4;
@@ -557,24 +465,7 @@ bool CJBig2_Image::ComposeToInternal(CJBig2_Image* pDst,
         if (d2 != 0) {
           uint32_t tmp1 = JBIG2_GETDWORD(sp);
           uint32_t tmp2 = JBIG2_GETDWORD(dp);
-          uint32_t tmp = 0;
-          switch (op) {
-            case JBIG2_COMPOSE_OR:
-              tmp = (tmp2 & ~maskR) | ((tmp1 | tmp2) & maskR);
-              break;
-            case JBIG2_COMPOSE_AND:
-              tmp = (tmp2 & ~maskR) | ((tmp1 & tmp2) & maskR);
-              break;
-            case JBIG2_COMPOSE_XOR:
-              tmp = (tmp2 & ~maskR) | ((tmp1 ^ tmp2) & maskR);
-              break;
-            case JBIG2_COMPOSE_XNOR:
-              tmp = (tmp2 & ~maskR) | ((~(tmp1 ^ tmp2)) & maskR);
-              break;
-            case JBIG2_COMPOSE_REPLACE:
-              tmp = (tmp2 & ~maskR) | (tmp1 & maskR);
-              break;
-          }
+          uint32_t tmp = ComposeWordMasked<op>(tmp1, tmp2, maskR);
           JBIG2_PUTDWORD(dp, tmp);
         }
         lineSrc += m_nStride;
@@ -592,24 +483,7 @@ bool CJBig2_Image::ComposeToInternal(CJBig2_Image* pDst,
         if (d1 != 0) {
           uint32_t tmp1 = JBIG2_GETDWORD(sp) >> shift1;
           uint32_t tmp2 = JBIG2_GETDWORD(dp);
-          uint32_t tmp = 0;
-          switch (op) {
-            case JBIG2_COMPOSE_OR:
-              tmp = (tmp2 & ~maskL) | ((tmp1 | tmp2) & maskL);
-              break;
-            case JBIG2_COMPOSE_AND:
-              tmp = (tmp2 & ~maskL) | ((tmp1 & tmp2) & maskL);
-              break;
-            case JBIG2_COMPOSE_XOR:
-              tmp = (tmp2 & ~maskL) | ((tmp1 ^ tmp2) & maskL);
-              break;
-            case JBIG2_COMPOSE_XNOR:
-              tmp = (tmp2 & ~maskL) | ((~(tmp1 ^ tmp2)) & maskL);
-              break;
-            case JBIG2_COMPOSE_REPLACE:
-              tmp = (tmp2 & ~maskL) | (tmp1 & maskL);
-              break;
-          }
+          uint32_t tmp = ComposeWordMasked<op>(tmp1, tmp2, maskL);
           JBIG2_PUTDWORD(dp, tmp);
           dp += 4;
         }
@@ -617,24 +491,7 @@ bool CJBig2_Image::ComposeToInternal(CJBig2_Image* pDst,
           uint32_t tmp1 = (JBIG2_GETDWORD(sp) << shift2) |
                           ((JBIG2_GETDWORD(sp + 4)) >> shift1);
           uint32_t tmp2 = JBIG2_GETDWORD(dp);
-          uint32_t tmp = 0;
-          switch (op) {
-            case JBIG2_COMPOSE_OR:
-              tmp = tmp1 | tmp2;
-              break;
-            case JBIG2_COMPOSE_AND:
-              tmp = tmp1 & tmp2;
-              break;
-            case JBIG2_COMPOSE_XOR:
-              tmp = tmp1 ^ tmp2;
-              break;
-            case JBIG2_COMPOSE_XNOR:
-              tmp = ~(tmp1 ^ tmp2);
-              break;
-            case JBIG2_COMPOSE_REPLACE:
-              tmp = tmp1;
-              break;
-          }
+          uint32_t tmp = ComposeWord<op>(tmp1, tmp2);
           JBIG2_PUTDWORD(dp, tmp);
           sp += 4;
           dp += 4;
@@ -645,24 +502,7 @@ bool CJBig2_Image::ComposeToInternal(CJBig2_Image* pDst,
               (((sp + 4) < lineSrc + lineLeft ? JBIG2_GETDWORD(sp + 4) : 0) >>
                shift1);
           uint32_t tmp2 = JBIG2_GETDWORD(dp);
-          uint32_t tmp = 0;
-          switch (op) {
-            case JBIG2_COMPOSE_OR:
-              tmp = (tmp2 & ~maskR) | ((tmp1 | tmp2) & maskR);
-              break;
-            case JBIG2_COMPOSE_AND:
-              tmp = (tmp2 & ~maskR) | ((tmp1 & tmp2) & maskR);
-              break;
-            case JBIG2_COMPOSE_XOR:
-              tmp = (tmp2 & ~maskR) | ((tmp1 ^ tmp2) & maskR);
-              break;
-            case JBIG2_COMPOSE_XNOR:
-              tmp = (tmp2 & ~maskR) | ((~(tmp1 ^ tmp2)) & maskR);
-              break;
-            case JBIG2_COMPOSE_REPLACE:
-              tmp = (tmp2 & ~maskR) | (tmp1 & maskR);
-              break;
-          }
+          uint32_t tmp = ComposeWordMasked<op>(tmp1, tmp2, maskR);
           JBIG2_PUTDWORD(dp, tmp);
         }
         lineSrc += m_nStride;
@@ -22,3 +22,15 @@ std::unique_ptr<CJBig2_SymbolDict> CJBig2_SymbolDict::DeepCopy() const {
   dst->m_grContext = m_grContext;
   return dst;
 }
+
+size_t CJBig2_SymbolDict::GetMemorySize() const {
+  size_t size = sizeof(*this);
+  for (const auto& image : m_SDEXSYMS) {
+    size += sizeof(image);
+    if (image)
+      size += sizeof(*image) +
+              static_cast<size_t>(image->stride()) * image->height();
+  }
+  size += (m_gbContext.size() + m_grContext.size()) * sizeof(JBig2ArithCtx);
+  return size;
+}
@@ -22,6 +22,9 @@ class CJBig2_SymbolDict {
 
   std::unique_ptr<CJBig2_SymbolDict> DeepCopy() const;
 
+  // Approximate heap footprint, for budgeting caches.
+  size_t GetMemorySize() const;
+
   void AddImage(std::unique_ptr<CJBig2_Image> image) {
     m_SDEXSYMS.push_back(std::move(image));
   }
@@ -1041,6 +1041,7 @@ class renderer_scanline_aa_offset {
 
 void CAgg_PathData::BuildPath(const CFX_PathData* pPathData,
                               const CFX_Matrix* pObject2Device) {
+  m_PathData.remove_all();
   pdfium::span<const FX_PATHPOINT> points = pPathData->GetPoints();
   for (size_t i = 0; i < points.size(); ++i) {
     CFX_PointF pos = points[i].m_Point;
@@ -1072,10 +1073,10 @@ void CAgg_PathData::BuildPath(const CFX_PathData* pPathData,
         pos0 = HardClip(pos0);
         pos2 = HardClip(pos2);
         pos3 = HardClip(pos3);
-        agg::curve4 curve(pos0.x, pos0.y, pos.x, pos.y, pos2.x, pos2.y, pos3.x,
-                          pos3.y);
+        m_Curve.init(pos0.x, pos0.y, pos.x, pos.y, pos2.x, pos2.y, pos3.x,
+                     pos3.y);
         i += 2;
-        m_PathData.add_path_curve(curve);
+        m_PathData.add_path_curve(m_Curve);
       }
     }
     if (points[i].m_CloseFigure)
@@ -1193,8 +1194,7 @@ void CFX_AggDeviceDriver::SetClipMask(agg::rasterizer_scanline_aa& rasterizer) {
   agg::renderer_scanline_aa_offset<agg::renderer_base<agg::pixfmt_gray8> >
       final_render(base_buf, path_rect.left, path_rect.top);
   final_render.color(agg::gray8(255));
-  agg::scanline_u8 scanline;
-  agg::render_scanlines(rasterizer, scanline, final_render,
+  agg::render_scanlines(rasterizer, m_Scanline, final_render,
                         m_FillOptions.aliased_path);
   m_pClipRgn->IntersectMaskF(path_rect.left, path_rect.top, pThisLayer);
 }
@@ -1223,13 +1223,10 @@ bool CFX_AggDeviceDriver::SetClip_PathFill(
       return true;
     }
   }
-  CAgg_PathData path_data;
+  CAgg_PathData& path_data = m_AggPath;
   path_data.BuildPath(pPathData, pObject2Device);
   path_data.m_PathData.end_poly();
-  agg::rasterizer_scanline_aa rasterizer;
-  rasterizer.clip_box(0.0f, 0.0f,
-                      static_cast<float>(GetDeviceCaps(FXDC_PIXEL_WIDTH)),
-                      static_cast<float>(GetDeviceCaps(FXDC_PIXEL_HEIGHT)));
+  agg::rasterizer_scanline_aa& rasterizer = PrepareRasterizer();
   rasterizer.add_path(path_data.m_PathData);
   rasterizer.filling_rule(GetAlternateOrWindingFillType(fill_options));
   SetClipMask(rasterizer);
@@ -1244,12 +1241,9 @@ bool CFX_AggDeviceDriver::SetClip_PathStroke(
     m_pClipRgn = std::make_unique<CFX_ClipRgn>(
         GetDeviceCaps(FXDC_PIXEL_WIDTH), GetDeviceCaps(FXDC_PIXEL_HEIGHT));
   }
-  CAgg_PathData path_data;
+  CAgg_PathData& path_data = m_AggPath;
   path_data.BuildPath(pPathData, nullptr);
-  agg::rasterizer_scanline_aa rasterizer;
-  rasterizer.clip_box(0.0f, 0.0f,
-                      static_cast<float>(GetDeviceCaps(FXDC_PIXEL_WIDTH)),
-                      static_cast<float>(GetDeviceCaps(FXDC_PIXEL_HEIGHT)));
+  agg::rasterizer_scanline_aa& rasterizer = PrepareRasterizer();
   RasterizeStroke(&rasterizer, &path_data.m_PathData, pObject2Device,
                   pGraphState, 1.0f, false);
   rasterizer.filling_rule(agg::fill_non_zero);
@@ -1257,6 +1251,15 @@ bool CFX_AggDeviceDriver::SetClip_PathStroke(
   return true;
 }
 
+agg::rasterizer_scanline_aa& CFX_AggDeviceDriver::PrepareRasterizer() {
+  m_Rasterizer.reset();
+  m_Rasterizer.filling_rule(agg::fill_non_zero);
+  m_Rasterizer.clip_box(0.0f, 0.0f,
+                        static_cast<float>(GetDeviceCaps(FXDC_PIXEL_WIDTH)),
+                        static_cast<float>(GetDeviceCaps(FXDC_PIXEL_HEIGHT)));
+  return m_Rasterizer;
+}
+
 int CFX_AggDeviceDriver::GetDriverType() const {
   return 1;
 }
@@ -1272,8 +1275,7 @@ bool CFX_AggDeviceDriver::RenderRasterizer(
                    m_bRgbByteOrder)) {
     return false;
   }
-  agg::scanline_u8 scanline;
-  agg::render_scanlines(rasterizer, scanline, render,
+  agg::render_scanlines(rasterizer, m_Scanline, render,
                         m_FillOptions.aliased_path);
   return true;
 }
@@ -1294,12 +1296,9 @@ bool CFX_AggDeviceDriver::DrawPath(const CFX_PathData* pPathData,
   m_FillOptions = fill_options;
   if (fill_options.fill_type != CFX_FillRenderOptions::FillType::kNoFill &&
       fill_color) {
-    CAgg_PathData path_data;
+    CAgg_PathData& path_data = m_AggPath;
     path_data.BuildPath(pPathData, pObject2Device);
-    agg::rasterizer_scanline_aa rasterizer;
-    rasterizer.clip_box(0.0f, 0.0f,
-                        static_cast<float>(GetDeviceCaps(FXDC_PIXEL_WIDTH)),
-                        static_cast<float>(GetDeviceCaps(FXDC_PIXEL_HEIGHT)));
+    agg::rasterizer_scanline_aa& rasterizer = PrepareRasterizer();
     rasterizer.add_path(path_data.m_PathData);
     rasterizer.filling_rule(GetAlternateOrWindingFillType(fill_options));
     if (!RenderRasterizer(rasterizer, fill_color, fill_options.full_cover,
@@ -1312,12 +1311,9 @@ bool CFX_AggDeviceDriver::DrawPath(const CFX_PathData* pPathData,
     return true;
 
   if (fill_options.zero_area) {
-    CAgg_PathData path_data;
+    CAgg_PathData& path_data = m_AggPath;
     path_data.BuildPath(pPathData, pObject2Device);
-    agg::rasterizer_scanline_aa rasterizer;
-    rasterizer.clip_box(0.0f, 0.0f,
-                        static_cast<float>(GetDeviceCaps(FXDC_PIXEL_WIDTH)),
-                        static_cast<float>(GetDeviceCaps(FXDC_PIXEL_HEIGHT)));
+    agg::rasterizer_scanline_aa& rasterizer = PrepareRasterizer();
     RasterizeStroke(&rasterizer, &path_data.m_PathData, nullptr, pGraphState, 1,
                     fill_options.stroke_text_mode);
     return RenderRasterizer(rasterizer, stroke_color, fill_options.full_cover,
@@ -1335,12 +1331,9 @@ bool CFX_AggDeviceDriver::DrawPath(const CFX_PathData* pPathData,
     matrix1 = *pObject2Device * matrix2.GetInverse();
   }
 
-  CAgg_PathData path_data;
+  CAgg_PathData& path_data = m_AggPath;
   path_data.BuildPath(pPathData, &matrix1);
-  agg::rasterizer_scanline_aa rasterizer;
-  rasterizer.clip_box(0.0f, 0.0f,
-                      static_cast<float>(GetDeviceCaps(FXDC_PIXEL_WIDTH)),
-                      static_cast<float>(GetDeviceCaps(FXDC_PIXEL_HEIGHT)));
+  agg::rasterizer_scanline_aa& rasterizer = PrepareRasterizer();
   RasterizeStroke(&rasterizer, &path_data.m_PathData, &matrix2, pGraphState,
                   matrix1.a, fill_options.stroke_text_mode);
   return RenderRasterizer(rasterizer, stroke_color, fill_options.full_cover,
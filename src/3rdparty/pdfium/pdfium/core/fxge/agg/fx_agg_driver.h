@@ -15,8 +15,10 @@
 #include "core/fxge/cfx_fillrenderoptions.h"
 #include "core/fxge/renderdevicedriver_iface.h"
 #include "third_party/agg23/agg_clip_liang_barsky.h"
+#include "third_party/agg23/agg_curves.h"
 #include "third_party/agg23/agg_path_storage.h"
 #include "third_party/agg23/agg_rasterizer_scanline_aa.h"
+#include "third_party/agg23/agg_scanline_u.h"
 
 class CFX_ClipRgn;
 class CFX_GraphStateData;
@@ -27,10 +29,15 @@ class CAgg_PathData {
  public:
   CAgg_PathData() {}
   ~CAgg_PathData() {}
+  // Replaces the contents of |m_PathData| with |pPathData|. Vertex and curve
+  // storage from earlier paths is reused.
   void BuildPath(const CFX_PathData* pPathData,
                  const CFX_Matrix* pObject2Device);
 
   agg::path_storage m_PathData;
+
+ private:
+  agg::curve4 m_Curve;
 };
 
 class CFX_AggDeviceDriver final : public RenderDeviceDriverIface {
@@ -113,6 +120,10 @@ class CFX_AggDeviceDriver final : public RenderDeviceDriverIface {
   virtual uint8_t* GetBuffer() const;
 
  private:
+  // Returns |m_Rasterizer| emptied and clipped to the device, ready for a new
+  // path. Its cell blocks are kept from previous paths.
+  agg::rasterizer_scanline_aa& PrepareRasterizer();
+
   RetainPtr<CFX_DIBitmap> const m_pBitmap;
   std::unique_ptr<CFX_ClipRgn> m_pClipRgn;
   std::vector<std::unique_ptr<CFX_ClipRgn>> m_StateStack;
@@ -123,6 +134,13 @@ class CFX_AggDeviceDriver final : public RenderDeviceDriverIface {
   const bool m_bRgbByteOrder;
   const bool m_bGroupKnockout;
   RetainPtr<CFX_DIBitmap> m_pBackdropBitmap;
+
+  // Reused by every path this driver fills or strokes, so pages with many
+  // small paths do not allocate and release vertex storage, rasterizer cell
+  // blocks and scanline buffers once per path.
+  agg::rasterizer_scanline_aa m_Rasterizer;
+  agg::scanline_u8 m_Scanline;
+  CAgg_PathData m_AggPath;
 };
 
 #endif  // CORE_FXGE_AGG_FX_AGG_DRIVER_H_
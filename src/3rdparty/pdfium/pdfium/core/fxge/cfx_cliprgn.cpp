@@ -6,11 +6,57 @@
 
 #include "core/fxge/cfx_cliprgn.h"
 
+#include <string.h>
+
+#include <algorithm>
 #include <utility>
 
 #include "core/fxge/dib/cfx_dibitmap.h"
 #include "base/logging.h"
 
+namespace {
+
+// Returns the smallest rectangle, relative to |mask|, that holds all of its
+// non-zero pixels. Sets |*opaque| when every pixel in that rectangle is 255,
+// i.e. when the mask is equivalent to the rectangle itself.
+FX_RECT GetMaskCoverage(const RetainPtr<CFX_DIBitmap>& mask, bool* opaque) {
+  const int width = mask->GetWidth();
+  const int height = mask->GetHeight();
+  FX_RECT coverage(width, height, 0, 0);
+  for (int row = 0; row < height; ++row) {
+    const uint8_t* scan = mask->GetScanline(row);
+    int left = 0;
+    while (left < width && !scan[left])
+      ++left;
+    if (left == width)
+      continue;
+
+    int right = width;
+    while (!scan[right - 1])
+      --right;
+    coverage.left = std::min(coverage.left, left);
+    coverage.right = std::max(coverage.right, right);
+    coverage.top = std::min(coverage.top, row);
+    coverage.bottom = row + 1;
+  }
+  *opaque = true;
+  if (coverage.IsEmpty())
+    return FX_RECT();
+
+  for (int row = coverage.top; row < coverage.bottom && *opaque; ++row) {
+    const uint8_t* scan = mask->GetScanline(row);
+    for (int col = coverage.left; col < coverage.right; ++col) {
+      if (scan[col] != 255) {
+        *opaque = false;
+        break;
+      }
+    }
+  }
+  return coverage;
+}
+
+}  // namespace
+
 CFX_ClipRgn::CFX_ClipRgn(int width, int height)
     : m_Type(RectI), m_Box(0, 0, width, height) {}
 
@@ -51,8 +97,7 @@ void CFX_ClipRgn::IntersectMaskRect(FX_RECT rect,
         m_Mask->GetBuffer() + m_Mask->GetPitch() * (row - m_Box.top);
     uint8_t* src_scan =
         pOldMask->GetBuffer() + pOldMask->GetPitch() * (row - mask_rect.top);
-    for (int col = m_Box.left; col < m_Box.right; col++)
-      dest_scan[col - m_Box.left] = src_scan[col - mask_rect.left];
+    memcpy(dest_scan, src_scan + m_Box.left - mask_rect.left, m_Box.Width());
   }
 }
 
@@ -60,15 +105,27 @@ void CFX_ClipRgn::IntersectMaskF(int left,
                                  int top,
                                  const RetainPtr<CFX_DIBitmap>& pMask) {
   ASSERT(pMask->GetFormat() == FXDIB_8bppMask);
+  // Masks rasterized from clip paths are often plain rectangles, or carry
+  // transparent borders. Keep the former analytic and trim the latter, so
+  // that later intersections and draws touch as few mask pixels as possible.
+  bool opaque;
+  FX_RECT coverage = GetMaskCoverage(pMask, &opaque);
+  coverage.Offset(left, top);
+  if (opaque) {
+    IntersectRect(coverage);
+    return;
+  }
   FX_RECT mask_box(left, top, left + pMask->GetWidth(),
                    top + pMask->GetHeight());
   if (m_Type == RectI) {
-    IntersectMaskRect(m_Box, mask_box, pMask);
+    FX_RECT rect = m_Box;
+    rect.Intersect(coverage);
+    IntersectMaskRect(rect, mask_box, pMask);
     return;
   }
   if (m_Type == MaskF) {
     FX_RECT new_box = m_Box;
-    new_box.Intersect(mask_box);
+    new_box.Intersect(coverage);
     if (new_box.IsEmpty()) {
       m_Type = RectI;
       m_Mask = nullptr;
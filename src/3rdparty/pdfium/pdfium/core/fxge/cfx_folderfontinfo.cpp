@@ -6,10 +6,13 @@
 
 #include "core/fxge/cfx_folderfontinfo.h"
 
+#include <sys/stat.h>
+
 #include <limits>
 #include <utility>
 
 #include "build/build_config.h"
+#include "core/fxcrt/cfx_binarybuf.h"
 #include "core/fxcrt/fx_codepage.h"
 #include "core/fxcrt/fx_memory_wrappers.h"
 #include "core/fxcrt/fx_safe_types.h"
@@ -18,6 +21,10 @@
 #include "core/fxge/fx_font.h"
 #include "base/stl_util.h"
 
+#if !defined(OS_WIN)
+#include <unistd.h>
+#endif
+
 #define CHARSET_FLAG_ANSI (1 << 0)
 #define CHARSET_FLAG_SYMBOL (1 << 1)
 #define CHARSET_FLAG_SHIFTJIS (1 << 2)
@@ -85,6 +92,84 @@ ByteString LoadTableFromTT(FILE* pFile,
   return ByteString();
 }
 
+// Order in which a face's charsets are reported to the font mapper.
+const struct {
+  uint32_t m_Flag;
+  int m_Charset;
+} kReportedCharsets[] = {
+    {CHARSET_FLAG_SHIFTJIS, FX_CHARSET_ShiftJIS},
+    {CHARSET_FLAG_GB, FX_CHARSET_ChineseSimplified},
+    {CHARSET_FLAG_BIG5, FX_CHARSET_ChineseTraditional},
+    {CHARSET_FLAG_KOREAN, FX_CHARSET_Hangul},
+    {CHARSET_FLAG_SYMBOL, FX_CHARSET_Symbol},
+    {CHARSET_FLAG_ANSI, FX_CHARSET_ANSI},
+};
+
+// Bump when the cache layout or the way faces are read changes.
+constexpr char kScanCacheMagic[8] = {'F', 'X', 'F', 'S', 'C', 'N', '0', '1'};
+constexpr size_t kMaxScanCacheSize = 64 * 1024 * 1024;
+
+void WriteUint32(CFX_BinaryBuf* buf, uint32_t value) {
+  buf->AppendBlock(&value, sizeof(value));
+}
+
+void WriteInt64(CFX_BinaryBuf* buf, int64_t value) {
+  buf->AppendBlock(&value, sizeof(value));
+}
+
+void WriteString(CFX_BinaryBuf* buf, const ByteString& str) {
+  WriteUint32(buf, str.GetLength());
+  buf->AppendString(str);
+}
+
+// Bounds-checked reader for the scan cache file. Any failure leaves the
+// reader in an error state, and the whole cache is then discarded.
+class ScanCacheReader {
+ public:
+  explicit ScanCacheReader(pdfium::span<const uint8_t> data) : m_Data(data) {}
+
+  bool IsAtEnd() const { return m_Pos == m_Data.size(); }
+
+  bool ReadBlock(void* dest, size_t size) {
+    if (size > m_Data.size() - m_Pos)
+      return false;
+    memcpy(dest, m_Data.data() + m_Pos, size);
+    m_Pos += size;
+    return true;
+  }
+
+  bool ReadUint32(uint32_t* value) { return ReadBlock(value, sizeof(*value)); }
+  bool ReadInt64(int64_t* value) { return ReadBlock(value, sizeof(*value)); }
+
+  bool ReadString(ByteString* str) {
+    uint32_t size;
+    if (!ReadUint32(&size) || size > m_Data.size() - m_Pos)
+      return false;
+    *str = ByteString(m_Data.data() + m_Pos, size);
+    m_Pos += size;
+    return true;
+  }
+
+ private:
+  const pdfium::span<const uint8_t> m_Data;
+  size_t m_Pos = 0;
+};
+
+bool GetFileStamp(const ByteString& path, int64_t* size, int64_t* mtime) {
+  struct stat st;
+  if (stat(path.c_str(), &st) != 0)
+    return false;
+
+  *size = st.st_size;
+#if defined(OS_LINUX) || defined(OS_CHROMEOS)
+  *mtime = static_cast<int64_t>(st.st_mtim.tv_sec) * 1000000000 +
+           st.st_mtim.tv_nsec;
+#else
+  *mtime = st.st_mtime;
+#endif
+  return true;
+}
+
 uint32_t GetCharset(int charset) {
   switch (charset) {
     case FX_CHARSET_ShiftJIS:
@@ -138,32 +223,64 @@ void CFX_FolderFontInfo::AddPath(const ByteString& path) {
   m_PathList.push_back(path);
 }
 
+void CFX_FolderFontInfo::SetScanCachePath(const ByteString& path) {
+  m_ScanCachePath = path;
+}
+
 bool CFX_FolderFontInfo::EnumFontList(CFX_FontMapper* pMapper) {
   m_pMapper = pMapper;
+  LoadScanCache();
   for (const auto& path : m_PathList)
     ScanPath(path);
+
+  // Every entry that was not re-read came from the old cache, so equal sizes
+  // mean no folder or font file disappeared either.
+  if (m_bScanCacheDirty ||
+      m_NewScanCache.folders.size() != m_OldScanCache.folders.size() ||
+      m_NewScanCache.files.size() != m_OldScanCache.files.size()) {
+    SaveScanCache();
+  }
+  m_OldScanCache = ScanCache();
+  m_NewScanCache = ScanCache();
+  m_bScanCacheDirty = false;
   return true;
 }
 
 void CFX_FolderFontInfo::ScanPath(const ByteString& path) {
-  std::unique_ptr<FX_FolderHandle, FxFolderHandleCloser> handle(
-      FX_OpenFolder(path.c_str()));
-  if (!handle)
-    return;
-
-  ByteString filename;
-  bool bFolder;
-  while (FX_GetNextFile(handle.get(), &filename, &bFolder)) {
-    if (bFolder) {
-      if (filename == "." || filename == "..")
-        continue;
-    } else {
-      ByteString ext = filename.Last(4);
-      ext.MakeLower();
-      if (ext != ".ttf" && ext != ".ttc" && ext != ".otf")
-        continue;
+  FileStamp stamp;
+  const bool bCache = !m_ScanCachePath.IsEmpty() &&
+                      GetFileStamp(path, &stamp.size, &stamp.mtime);
+  FolderEntries entries;
+  auto it = m_OldScanCache.folders.find(path);
+  if (bCache && it != m_OldScanCache.folders.end() &&
+      it->second.stamp == stamp) {
+    entries = it->second.entries;
+  } else {
+    std::unique_ptr<FX_FolderHandle, FxFolderHandleCloser> handle(
+        FX_OpenFolder(path.c_str()));
+    if (!handle)
+      return;
+
+    ByteString filename;
+    bool bFolder;
+    while (FX_GetNextFile(handle.get(), &filename, &bFolder)) {
+      if (bFolder) {
+        if (filename == "." || filename == "..")
+          continue;
+      } else {
+        ByteString ext = filename.Last(4);
+        ext.MakeLower();
+        if (ext != ".ttf" && ext != ".ttc" && ext != ".otf")
+          continue;
+      }
+      entries.emplace_back(filename, bFolder);
     }
+    m_bScanCacheDirty = true;
+  }
+  if (bCache)
+    m_NewScanCache.folders[path] = {stamp, entries};
 
+  for (const auto& entry : entries) {
     ByteString fullpath = path;
 #if defined(OS_WIN)
     fullpath += "\\";
@@ -171,28 +288,51 @@ void CFX_FolderFontInfo::ScanPath(const ByteString& path) {
     fullpath += "/";
 #endif
 
-    fullpath += filename;
-    bFolder ? ScanPath(fullpath) : ScanFile(fullpath);
+    fullpath += entry.first;
+    entry.second ? ScanPath(fullpath) : ScanFile(fullpath);
   }
 }
 
 void CFX_FolderFontInfo::ScanFile(const ByteString& path) {
-  std::unique_ptr<FILE, FxFileCloser> pFile(fopen(path.c_str(), "rb"));
-  if (!pFile)
+  FileStamp stamp;
+  const bool bCache = !m_ScanCachePath.IsEmpty() &&
+                      GetFileStamp(path, &stamp.size, &stamp.mtime);
+  auto it = m_OldScanCache.files.find(path);
+  if (bCache && it != m_OldScanCache.files.end() &&
+      it->second.stamp == stamp) {
+    for (const auto& face : it->second.faces)
+      AddFace(face);
+    m_NewScanCache.files.emplace(path, it->second);
     return;
+  }
 
-  fseek(pFile.get(), 0, SEEK_END);
+  std::vector<FontFaceInfo> faces;
+  std::unique_ptr<FILE, FxFileCloser> pFile(fopen(path.c_str(), "rb"));
+  if (pFile)
+    ReadFaces(path, pFile.get(), &faces);
+  for (const auto& face : faces)
+    AddFace(face);
+  if (bCache) {
+    m_NewScanCache.files[path] = {stamp, std::move(faces)};
+    m_bScanCacheDirty = true;
+  }
+}
+
+void CFX_FolderFontInfo::ReadFaces(const ByteString& path,
+                                   FILE* pFile,
+                                   std::vector<FontFaceInfo>* faces) {
+  fseek(pFile, 0, SEEK_END);
 
-  uint32_t filesize = ftell(pFile.get());
+  uint32_t filesize = ftell(pFile);
   uint8_t buffer[16];
-  fseek(pFile.get(), 0, SEEK_SET);
+  fseek(pFile, 0, SEEK_SET);
 
-  size_t readCnt = fread(buffer, 12, 1, pFile.get());
+  size_t readCnt = fread(buffer, 12, 1, pFile);
   if (readCnt != 1)
     return;
 
   if (GET_TT_LONG(buffer) != kTableTTCF) {
-    ReportFace(path, pFile.get(), filesize, 0);
+    ReportFace(path, pFile, filesize, 0, faces);
     return;
   }
 
@@ -205,19 +345,21 @@ void CFX_FolderFontInfo::ScanFile(const ByteString& path) {
   const size_t face_bytes = safe_face_bytes.ValueOrDie();
   std::unique_ptr<uint8_t, FxFreeDeleter> offsets(
       FX_Alloc(uint8_t, face_bytes));
-  readCnt = fread(offsets.get(), 1, face_bytes, pFile.get());
+  readCnt = fread(offsets.get(), 1, face_bytes, pFile);
   if (readCnt != face_bytes)
     return;
 
   auto offsets_span = pdfium::make_span(offsets.get(), face_bytes);
   for (uint32_t i = 0; i < nFaces; i++)
-    ReportFace(path, pFile.get(), filesize, GET_TT_LONG(&offsets_span[i * 4]));
+    ReportFace(path, pFile, filesize, GET_TT_LONG(&offsets_span[i * 4]),
+               faces);
 }
 
 void CFX_FolderFontInfo::ReportFace(const ByteString& path,
                                     FILE* pFile,
                                     uint32_t filesize,
-                                    uint32_t offset) {
+                                    uint32_t offset,
+                                    std::vector<FontFaceInfo>* faces) {
   char buffer[16];
   if (fseek(pFile, offset, SEEK_SET) < 0 || !fread(buffer, 12, 1, pFile))
     return;
@@ -240,48 +382,184 @@ void CFX_FolderFontInfo::ReportFace(const ByteString& path,
   if (style != "Regular")
     facename += " " + style;
 
-  if (pdfium::Contains(m_FontList, facename))
-    return;
-
-  auto pInfo =
-      std::make_unique<FontFaceInfo>(path, facename, tables, offset, filesize);
+  FontFaceInfo info(path, facename, tables, offset, filesize);
   ByteString os2 =
       LoadTableFromTT(pFile, tables.raw_str(), nTables, 0x4f532f32, filesize);
   if (os2.GetLength() >= 86) {
     const uint8_t* p = os2.raw_str() + 78;
     uint32_t codepages = GET_TT_LONG(p);
-    if (codepages & (1U << 17)) {
-      m_pMapper->AddInstalledFont(facename, FX_CHARSET_ShiftJIS);
-      pInfo->m_Charsets |= CHARSET_FLAG_SHIFTJIS;
+    if (codepages & (1U << 17))
+      info.m_Charsets |= CHARSET_FLAG_SHIFTJIS;
+    if (codepages & (1U << 18))
+      info.m_Charsets |= CHARSET_FLAG_GB;
+    if (codepages & (1U << 20))
+      info.m_Charsets |= CHARSET_FLAG_BIG5;
+    if ((codepages & (1U << 19)) || (codepages & (1U << 21)))
+      info.m_Charsets |= CHARSET_FLAG_KOREAN;
+    if (codepages & (1U << 31))
+      info.m_Charsets |= CHARSET_FLAG_SYMBOL;
+  }
+  info.m_Charsets |= CHARSET_FLAG_ANSI;
+  info.m_Styles = 0;
+  if (style.Contains("Bold"))
+    info.m_Styles |= FXFONT_FORCE_BOLD;
+  if (style.Contains("Italic") || style.Contains("Oblique"))
+    info.m_Styles |= FXFONT_ITALIC;
+  if (facename.Contains("Serif"))
+    info.m_Styles |= FXFONT_SERIF;
+
+  faces->push_back(info);
+}
+
+void CFX_FolderFontInfo::AddFace(const FontFaceInfo& face) {
+  if (pdfium::Contains(m_FontList, face.m_FaceName))
+    return;
+
+  for (const auto& reported : kReportedCharsets) {
+    if (face.m_Charsets & reported.m_Flag)
+      m_pMapper->AddInstalledFont(face.m_FaceName, reported.m_Charset);
+  }
+  m_FontList[face.m_FaceName] = std::make_unique<FontFaceInfo>(face);
+}
+
+void CFX_FolderFontInfo::LoadScanCache() {
+  if (m_ScanCachePath.IsEmpty())
+    return;
+
+  std::unique_ptr<FILE, FxFileCloser> pFile(
+      fopen(m_ScanCachePath.c_str(), "rb"));
+  if (!pFile || fseek(pFile.get(), 0, SEEK_END) < 0)
+    return;
+
+  long size = ftell(pFile.get());
+  if (size <= 0 || static_cast<size_t>(size) > kMaxScanCacheSize ||
+      fseek(pFile.get(), 0, SEEK_SET) < 0) {
+    return;
+  }
+
+  std::vector<uint8_t, FxAllocAllocator<uint8_t>> data(size);
+  if (fread(data.data(), size, 1, pFile.get()) != 1)
+    return;
+
+  ScanCacheReader reader(data);
+  char magic[sizeof(kScanCacheMagic)];
+  if (!reader.ReadBlock(magic, sizeof(magic)) ||
+      memcmp(magic, kScanCacheMagic, sizeof(magic)) != 0) {
+    return;
+  }
+
+  ScanCache cache;
+  uint32_t nFolders;
+  if (!reader.ReadUint32(&nFolders))
+    return;
+  for (uint32_t i = 0; i < nFolders; ++i) {
+    ByteString path;
+    ScanCache::Folder folder;
+    uint32_t nEntries;
+    if (!reader.ReadString(&path) || !reader.ReadInt64(&folder.stamp.size) ||
+        !reader.ReadInt64(&folder.stamp.mtime) ||
+        !reader.ReadUint32(&nEntries)) {
+      return;
     }
-    if (codepages & (1U << 18)) {
-      m_pMapper->AddInstalledFont(facename, FX_CHARSET_ChineseSimplified);
-      pInfo->m_Charsets |= CHARSET_FLAG_GB;
+    for (uint32_t j = 0; j < nEntries; ++j) {
+      ByteString name;
+      uint32_t bFolder;
+      if (!reader.ReadString(&name) || !reader.ReadUint32(&bFolder))
+        return;
+      folder.entries.emplace_back(name, !!bFolder);
     }
-    if (codepages & (1U << 20)) {
-      m_pMapper->AddInstalledFont(facename, FX_CHARSET_ChineseTraditional);
-      pInfo->m_Charsets |= CHARSET_FLAG_BIG5;
+    cache.folders[path] = std::move(folder);
+  }
+
+  uint32_t nFiles;
+  if (!reader.ReadUint32(&nFiles))
+    return;
+  for (uint32_t i = 0; i < nFiles; ++i) {
+    ByteString path;
+    ScanCache::File file;
+    uint32_t nFaces;
+    if (!reader.ReadString(&path) || !reader.ReadInt64(&file.stamp.size) ||
+        !reader.ReadInt64(&file.stamp.mtime) || !reader.ReadUint32(&nFaces)) {
+      return;
     }
-    if ((codepages & (1U << 19)) || (codepages & (1U << 21))) {
-      m_pMapper->AddInstalledFont(facename, FX_CHARSET_Hangul);
-      pInfo->m_Charsets |= CHARSET_FLAG_KOREAN;
+    for (uint32_t j = 0; j < nFaces; ++j) {
+      ByteString facename;
+      ByteString tables;
+      uint32_t offset;
+      uint32_t filesize;
+      uint32_t styles;
+      uint32_t charsets;
+      if (!reader.ReadString(&facename) || !reader.ReadString(&tables) ||
+          !reader.ReadUint32(&offset) || !reader.ReadUint32(&filesize) ||
+          !reader.ReadUint32(&styles) || !reader.ReadUint32(&charsets)) {
+        return;
+      }
+      file.faces.emplace_back(path, facename, tables, offset, filesize);
+      file.faces.back().m_Styles = styles;
+      file.faces.back().m_Charsets = charsets;
     }
-    if (codepages & (1U << 31)) {
-      m_pMapper->AddInstalledFont(facename, FX_CHARSET_Symbol);
-      pInfo->m_Charsets |= CHARSET_FLAG_SYMBOL;
+    cache.files[path] = std::move(file);
+  }
+  if (reader.IsAtEnd())
+    m_OldScanCache = std::move(cache);
+}
+
+void CFX_FolderFontInfo::SaveScanCache() const {
+  if (m_ScanCachePath.IsEmpty())
+    return;
+
+  CFX_BinaryBuf buf;
+  buf.AppendBlock(kScanCacheMagic, sizeof(kScanCacheMagic));
+  WriteUint32(&buf, m_NewScanCache.folders.size());
+  for (const auto& it : m_NewScanCache.folders) {
+    WriteString(&buf, it.first);
+    WriteInt64(&buf, it.second.stamp.size);
+    WriteInt64(&buf, it.second.stamp.mtime);
+    WriteUint32(&buf, it.second.entries.size());
+    for (const auto& entry : it.second.entries) {
+      WriteString(&buf, entry.first);
+      WriteUint32(&buf, entry.second);
+    }
+  }
+  WriteUint32(&buf, m_NewScanCache.files.size());
+  for (const auto& it : m_NewScanCache.files) {
+    WriteString(&buf, it.first);
+    WriteInt64(&buf, it.second.stamp.size);
+    WriteInt64(&buf, it.second.stamp.mtime);
+    WriteUint32(&buf, it.second.faces.size());
+    for (const auto& face : it.second.faces) {
+      WriteString(&buf, face.m_FaceName);
+      WriteString(&buf, face.m_FontTables);
+      WriteUint32(&buf, face.m_FontOffset);
+      WriteUint32(&buf, face.m_FileSize);
+      WriteUint32(&buf, face.m_Styles);
+      WriteUint32(&buf, face.m_Charsets);
     }
   }
-  m_pMapper->AddInstalledFont(facename, FX_CHARSET_ANSI);
-  pInfo->m_Charsets |= CHARSET_FLAG_ANSI;
-  pInfo->m_Styles = 0;
-  if (style.Contains("Bold"))
-    pInfo->m_Styles |= FXFONT_FORCE_BOLD;
-  if (style.Contains("Italic") || style.Contains("Oblique"))
-    pInfo->m_Styles |= FXFONT_ITALIC;
-  if (facename.Contains("Serif"))
-    pInfo->m_Styles |= FXFONT_SERIF;
 
-  m_FontList[facename] = std::move(pInfo);
+  // Write to a private file first, so that concurrent readers and writers
+  // only ever see a complete cache.
+  ByteString temp_path = m_ScanCachePath;
+#if !defined(OS_WIN)
+  temp_path += ByteString::Format(".%d", static_cast<int>(getpid()));
+#endif
+  temp_path += ".tmp";
+  {
+    std::unique_ptr<FILE, FxFileCloser> pFile(fopen(temp_path.c_str(), "wb"));
+    if (!pFile)
+      return;
+    if (fwrite(buf.GetBuffer(), buf.GetSize(), 1, pFile.get()) != 1 ||
+        fflush(pFile.get()) != 0) {
+      pFile.reset();
+      remove(temp_path.c_str());
+      return;
+    }
+  }
+#if defined(OS_WIN)
+  remove(m_ScanCachePath.c_str());
+#endif
+  if (rename(temp_path.c_str(), m_ScanCachePath.c_str()) != 0)
+    remove(temp_path.c_str());
 }
 
 void* CFX_FolderFontInfo::GetSubstFont(const ByteString& face) {
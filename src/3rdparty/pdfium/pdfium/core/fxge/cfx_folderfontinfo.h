@@ -10,6 +10,7 @@
 #include <cstdint>
 #include <map>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "core/fxcrt/unowned_ptr.h"
@@ -23,6 +24,11 @@ class CFX_FolderFontInfo : public SystemFontInfoIface {
 
   void AddPath(const ByteString& path);
 
+  // Keeps the results of scanning the font folders in the file at |path|, so
+  // that later EnumFontList() calls only re-read folders and font files whose
+  // size or modification time changed. An empty |path| disables the cache.
+  void SetScanCachePath(const ByteString& path);
+
   // IFX_SytemFontInfo:
   bool EnumFontList(CFX_FontMapper* pMapper) override;
   void* MapFont(int weight,
@@ -58,12 +64,46 @@ class CFX_FolderFontInfo : public SystemFontInfoIface {
     uint32_t m_Charsets;
   };
 
+  struct FileStamp {
+    bool operator==(const FileStamp& that) const {
+      return size == that.size && mtime == that.mtime;
+    }
+
+    int64_t size = 0;
+    int64_t mtime = 0;
+  };
+
+  // Folder entries that passed the font file filter, in directory order. The
+  // bool is true for sub-folders.
+  using FolderEntries = std::vector<std::pair<ByteString, bool>>;
+
+  struct ScanCache {
+    struct Folder {
+      FileStamp stamp;
+      FolderEntries entries;
+    };
+    struct File {
+      FileStamp stamp;
+      std::vector<FontFaceInfo> faces;
+    };
+
+    std::map<ByteString, Folder> folders;
+    std::map<ByteString, File> files;
+  };
+
   void ScanPath(const ByteString& path);
   void ScanFile(const ByteString& path);
+  void ReadFaces(const ByteString& path,
+                 FILE* pFile,
+                 std::vector<FontFaceInfo>* faces);
   void ReportFace(const ByteString& path,
                   FILE* pFile,
                   uint32_t filesize,
-                  uint32_t offset);
+                  uint32_t offset,
+                  std::vector<FontFaceInfo>* faces);
+  void AddFace(const FontFaceInfo& face);
+  void LoadScanCache();
+  void SaveScanCache() const;
   void* GetSubstFont(const ByteString& face);
   void* FindFont(int weight,
                  bool bItalic,
@@ -75,6 +115,12 @@ class CFX_FolderFontInfo : public SystemFontInfoIface {
   std::map<ByteString, std::unique_ptr<FontFaceInfo>> m_FontList;
   std::vector<ByteString> m_PathList;
   UnownedPtr<CFX_FontMapper> m_pMapper;
+  ByteString m_ScanCachePath;
+  // Entries read from |m_ScanCachePath|, and the entries seen by the current
+  // EnumFontList() call, which replace them when anything changed.
+  ScanCache m_OldScanCache;
+  ScanCache m_NewScanCache;
+  bool m_bScanCacheDirty = false;
 };
 
 #endif  // CORE_FXGE_CFX_FOLDERFONTINFO_H_
@@ -6,11 +6,22 @@
 
 #include "core/fxge/cfx_fontcache.h"
 
+#include <algorithm>
+
 #include "core/fxge/cfx_font.h"
 #include "core/fxge/cfx_glyphcache.h"
 #include "core/fxge/fx_font.h"
 #include "core/fxge/fx_freetype.h"
 
+namespace {
+
+// Upper bound for glyph bitmaps kept across all faces. Trimming goes down to
+// three quarters of it so that eviction does not run on every text run.
+constexpr size_t kGlyphCacheBudget = 32 * 1024 * 1024;
+constexpr size_t kGlyphCacheTrimTarget = kGlyphCacheBudget / 4 * 3;
+
+}  // namespace
+
 CFX_FontCache::CFX_FontCache() = default;
 
 CFX_FontCache::~CFX_FontCache() = default;
@@ -28,6 +39,45 @@ RetainPtr<CFX_GlyphCache> CFX_FontCache::GetGlyphCache(const CFX_Font* pFont) {
   return new_cache;
 }
 
+void CFX_FontCache::TrimGlyphCaches() {
+  size_t total_bytes = CFX_GlyphCache::GetTotalBitmapBytes();
+  if (total_bytes <= kGlyphCacheBudget)
+    return;
+
+  std::vector<CFX_GlyphCache*> caches;
+  CollectLiveGlyphCaches(&m_GlyphCacheMap, &caches);
+  CollectLiveGlyphCaches(&m_ExtGlyphCacheMap, &caches);
+
+  std::vector<std::pair<uint64_t, size_t>> usage;
+  for (CFX_GlyphCache* pCache : caches)
+    pCache->GetSizeCacheUsage(&usage);
+  std::sort(usage.begin(), usage.end());
+
+  uint64_t evict_before = 0;
+  for (const auto& size : usage) {
+    if (total_bytes <= kGlyphCacheTrimTarget)
+      break;
+    total_bytes -= size.second;
+    evict_before = size.first + 1;
+  }
+  for (CFX_GlyphCache* pCache : caches)
+    pCache->EvictSizeCachesUsedBefore(evict_before);
+}
+
+// static
+void CFX_FontCache::CollectLiveGlyphCaches(
+    GlyphCacheMap* map,
+    std::vector<CFX_GlyphCache*>* caches) {
+  for (auto it = map->begin(); it != map->end();) {
+    if (it->second) {
+      caches->push_back(it->second.Get());
+      ++it;
+    } else {
+      it = map->erase(it);
+    }
+  }
+}
+
 #if defined(_SKIA_SUPPORT_)
 CFX_TypeFace* CFX_FontCache::GetDeviceCache(const CFX_Font* pFont) {
   return GetGlyphCache(pFont)->GetDeviceCache(pFont);
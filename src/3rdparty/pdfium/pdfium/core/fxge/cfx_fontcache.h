@@ -9,6 +9,8 @@
 
 #include <map>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "core/fxcrt/fx_system.h"
 #include "core/fxge/cfx_glyphcache.h"
@@ -22,13 +24,23 @@ class CFX_FontCache {
   ~CFX_FontCache();
 
   RetainPtr<CFX_GlyphCache> GetGlyphCache(const CFX_Font* pFont);
+
+  // Evicts the least recently used glyph sizes once the glyph bitmaps of all
+  // faces exceed the cache budget. Invalidates glyph bitmap pointers, so it
+  // must only be called between text runs.
+  void TrimGlyphCaches();
 #if defined(_SKIA_SUPPORT_)
   CFX_TypeFace* GetDeviceCache(const CFX_Font* pFont);
 #endif
 
  private:
-  std::map<CFX_Face*, ObservedPtr<CFX_GlyphCache>> m_GlyphCacheMap;
-  std::map<CFX_Face*, ObservedPtr<CFX_GlyphCache>> m_ExtGlyphCacheMap;
+  using GlyphCacheMap = std::map<CFX_Face*, ObservedPtr<CFX_GlyphCache>>;
+
+  static void CollectLiveGlyphCaches(GlyphCacheMap* map,
+                                     std::vector<CFX_GlyphCache*>* caches);
+
+  GlyphCacheMap m_GlyphCacheMap;
+  GlyphCacheMap m_ExtGlyphCacheMap;
 };
 
 #endif  // CORE_FXGE_CFX_FONTCACHE_H_
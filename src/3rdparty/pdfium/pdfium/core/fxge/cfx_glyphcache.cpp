@@ -44,63 +44,112 @@ constexpr uint32_t kInvalidGlyphIndex = static_cast<uint32_t>(-1);
 
 constexpr int kMaxGlyphDimension = 2048;
 
-struct UniqueKeyGen {
-  void Generate(int count, ...);
-
-  int key_len_;
-  char key_[128];
-};
-
-void UniqueKeyGen::Generate(int count, ...) {
-  va_list argList;
-  va_start(argList, count);
-  for (int i = 0; i < count; i++) {
-    int p = va_arg(argList, int);
-    reinterpret_cast<uint32_t*>(key_)[i] = p;
-  }
-  va_end(argList);
-  key_len_ = count * sizeof(uint32_t);
+// Bytes held by glyph bitmaps across all CFX_GlyphCache instances.
+size_t g_GlyphBitmapBytes = 0;
+
+// Advances on every glyph lookup; size caches remember the value of their
+// last use so CFX_FontCache can evict the least recently used ones.
+uint64_t g_GlyphCacheTick = 0;
+
+size_t GetGlyphBitmapBytes(const CFX_GlyphBitmap* pGlyphBitmap) {
+  if (!pGlyphBitmap)
+    return 0;
+
+  const RetainPtr<CFX_DIBitmap>& pBitmap = pGlyphBitmap->GetBitmap();
+  return sizeof(CFX_GlyphBitmap) + sizeof(CFX_DIBitmap) +
+         static_cast<size_t>(pBitmap->GetPitch()) * pBitmap->GetHeight();
 }
 
-void GenKey(UniqueKeyGen* pKeyGen,
-            const CFX_Font* pFont,
-            const CFX_Matrix& matrix,
-            int dest_width,
-            int anti_alias,
-            bool bNative) {
-  int nMatrixA = static_cast<int>(matrix.a * 10000);
-  int nMatrixB = static_cast<int>(matrix.b * 10000);
-  int nMatrixC = static_cast<int>(matrix.c * 10000);
-  int nMatrixD = static_cast<int>(matrix.d * 10000);
-
-  if (bNative) {
-    if (pFont->GetSubstFont()) {
-      pKeyGen->Generate(10, nMatrixA, nMatrixB, nMatrixC, nMatrixD, dest_width,
-                        anti_alias, pFont->GetSubstFont()->m_Weight,
-                        pFont->GetSubstFont()->m_ItalicAngle,
-                        pFont->IsVertical(), 3);
-    } else {
-      pKeyGen->Generate(7, nMatrixA, nMatrixB, nMatrixC, nMatrixD, dest_width,
-                        anti_alias, 3);
-    }
-  } else {
-    if (pFont->GetSubstFont()) {
-      pKeyGen->Generate(9, nMatrixA, nMatrixB, nMatrixC, nMatrixD, dest_width,
-                        anti_alias, pFont->GetSubstFont()->m_Weight,
-                        pFont->GetSubstFont()->m_ItalicAngle,
-                        pFont->IsVertical());
+}  // namespace
+
+bool CFX_GlyphCache::SizeKey::operator<(const SizeKey& that) const {
+  return std::tie(matrix[0], matrix[1], matrix[2], matrix[3], dest_width,
+                  anti_alias, weight, italic_angle, vertical, has_subst_font,
+                  native) <
+         std::tie(that.matrix[0], that.matrix[1], that.matrix[2],
+                  that.matrix[3], that.dest_width, that.anti_alias,
+                  that.weight, that.italic_angle, that.vertical,
+                  that.has_subst_font, that.native);
+}
+
+CFX_GlyphCache::SizeGlyphCache::SizeGlyphCache() = default;
+
+CFX_GlyphCache::SizeGlyphCache::SizeGlyphCache(SizeGlyphCache&&) = default;
+
+CFX_GlyphCache::SizeGlyphCache& CFX_GlyphCache::SizeGlyphCache::operator=(
+    SizeGlyphCache&&) = default;
+
+CFX_GlyphCache::SizeGlyphCache::~SizeGlyphCache() = default;
+
+// static
+size_t CFX_GlyphCache::GetTotalBitmapBytes() {
+  return g_GlyphBitmapBytes;
+}
+
+// static
+CFX_GlyphCache::SizeKey CFX_GlyphCache::GenKey(const CFX_Font* pFont,
+                                               const CFX_Matrix& matrix,
+                                               int dest_width,
+                                               int anti_alias,
+                                               bool bNative) {
+  SizeKey key;
+  key.matrix[0] = static_cast<int>(matrix.a * 10000);
+  key.matrix[1] = static_cast<int>(matrix.b * 10000);
+  key.matrix[2] = static_cast<int>(matrix.c * 10000);
+  key.matrix[3] = static_cast<int>(matrix.d * 10000);
+  key.dest_width = dest_width;
+  key.anti_alias = anti_alias;
+  const CFX_SubstFont* pSubstFont = pFont->GetSubstFont();
+  key.has_subst_font = !!pSubstFont;
+  key.weight = pSubstFont ? pSubstFont->m_Weight : 0;
+  key.italic_angle = pSubstFont ? pSubstFont->m_ItalicAngle : 0;
+  key.vertical = pSubstFont && pFont->IsVertical();
+  key.native = bNative;
+  return key;
+}
+
+CFX_GlyphCache::CFX_GlyphCache(RetainPtr<CFX_Face> face) : m_Face(face) {}
+
+CFX_GlyphCache::~CFX_GlyphCache() {
+  for (const auto& size : m_SizeMap)
+    g_GlyphBitmapBytes -= size.second.bitmap_bytes;
+}
+
+void CFX_GlyphCache::GetSizeCacheUsage(
+    std::vector<std::pair<uint64_t, size_t>>* usage) const {
+  for (const auto& size : m_SizeMap)
+    usage->emplace_back(size.second.last_used, size.second.bitmap_bytes);
+}
+
+void CFX_GlyphCache::EvictSizeCachesUsedBefore(uint64_t tick) {
+  for (auto it = m_SizeMap.begin(); it != m_SizeMap.end();) {
+    if (it->second.last_used < tick) {
+      g_GlyphBitmapBytes -= it->second.bitmap_bytes;
+      it = m_SizeMap.erase(it);
     } else {
-      pKeyGen->Generate(6, nMatrixA, nMatrixB, nMatrixC, nMatrixD, dest_width,
-                        anti_alias);
+      ++it;
     }
   }
 }
 
-}  // namespace
-
-CFX_GlyphCache::CFX_GlyphCache(RetainPtr<CFX_Face> face) : m_Face(face) {}
+CFX_GlyphCache::SizeGlyphCache* CFX_GlyphCache::GetSizeCache(
+    const SizeKey& key) {
+  SizeGlyphCache* pSizeCache = &m_SizeMap[key];
+  pSizeCache->last_used = ++g_GlyphCacheTick;
+  return pSizeCache;
+}
 
-CFX_GlyphCache::~CFX_GlyphCache() = default;
+CFX_GlyphBitmap* CFX_GlyphCache::AddGlyphBitmap(
+    SizeGlyphCache* pSizeCache,
+    uint32_t glyph_index,
+    std::unique_ptr<CFX_GlyphBitmap> pBitmap) {
+  CFX_GlyphBitmap* pResult = pBitmap.get();
+  size_t bytes = GetGlyphBitmapBytes(pResult);
+  pSizeCache->bitmap_bytes += bytes;
+  g_GlyphBitmapBytes += bytes;
+  pSizeCache->glyphs[glyph_index] = std::move(pBitmap);
+  return pResult;
+}
 
 std::unique_ptr<CFX_GlyphBitmap> CFX_GlyphCache::RenderGlyph(
     const CFX_Font* pFont,
@@ -250,14 +299,12 @@ const CFX_GlyphBitmap* CFX_GlyphCache::LoadGlyphBitmap(
   if (glyph_index == kInvalidGlyphIndex)
     return nullptr;
 
-  UniqueKeyGen keygen;
 #if defined(OS_APPLE)
   const bool bNative = text_options->native_text;
 #else
   const bool bNative = false;
 #endif
-  GenKey(&keygen, pFont, matrix, dest_width, anti_alias, bNative);
-  ByteString FaceGlyphsKey(keygen.key_, keygen.key_len_);
+  SizeKey key = GenKey(pFont, matrix, dest_width, anti_alias, bNative);
 
 #if defined(OS_APPLE) && !defined(_SKIA_SUPPORT_) && \
     !defined(_SKIA_SUPPORT_PATHS_)
@@ -266,45 +313,27 @@ const CFX_GlyphBitmap* CFX_GlyphCache::LoadGlyphBitmap(
   const bool bDoLookUp = true;
 #endif
   if (bDoLookUp) {
-    return LookUpGlyphBitmap(pFont, matrix, FaceGlyphsKey, glyph_index,
-                             bFontStyle, dest_width, anti_alias);
+    return LookUpGlyphBitmap(pFont, matrix, key, glyph_index, bFontStyle,
+                             dest_width, anti_alias);
   }
 
 #if defined(OS_APPLE) && !defined(_SKIA_SUPPORT_) && \
     !defined(_SKIA_SUPPORT_PATHS_)
-  std::unique_ptr<CFX_GlyphBitmap> pGlyphBitmap;
-  auto it = m_SizeMap.find(FaceGlyphsKey);
-  if (it != m_SizeMap.end()) {
-    SizeGlyphCache* pSizeCache = &(it->second);
-    auto it2 = pSizeCache->find(glyph_index);
-    if (it2 != pSizeCache->end())
-      return it2->second.get();
-
-    pGlyphBitmap = RenderGlyph_Nativetext(pFont, glyph_index, matrix,
-                                          dest_width, anti_alias);
-    if (pGlyphBitmap) {
-      CFX_GlyphBitmap* pResult = pGlyphBitmap.get();
-      (*pSizeCache)[glyph_index] = std::move(pGlyphBitmap);
-      return pResult;
-    }
-  } else {
-    pGlyphBitmap = RenderGlyph_Nativetext(pFont, glyph_index, matrix,
-                                          dest_width, anti_alias);
-    if (pGlyphBitmap) {
-      CFX_GlyphBitmap* pResult = pGlyphBitmap.get();
+  SizeGlyphCache* pSizeCache = GetSizeCache(key);
+  auto it = pSizeCache->glyphs.find(glyph_index);
+  if (it != pSizeCache->glyphs.end())
+    return it->second.get();
 
-      SizeGlyphCache cache;
-      cache[glyph_index] = std::move(pGlyphBitmap);
+  std::unique_ptr<CFX_GlyphBitmap> pGlyphBitmap = RenderGlyph_Nativetext(
+      pFont, glyph_index, matrix, dest_width, anti_alias);
+  if (pGlyphBitmap)
+    return AddGlyphBitmap(pSizeCache, glyph_index, std::move(pGlyphBitmap));
 
-      m_SizeMap[FaceGlyphsKey] = std::move(cache);
-      return pResult;
-    }
-  }
-  GenKey(&keygen, pFont, matrix, dest_width, anti_alias, /*bNative=*/false);
-  ByteString FaceGlyphsKey2(keygen.key_, keygen.key_len_);
   text_options->native_text = false;
-  return LookUpGlyphBitmap(pFont, matrix, FaceGlyphsKey2, glyph_index,
-                           bFontStyle, dest_width, anti_alias);
+  return LookUpGlyphBitmap(
+      pFont, matrix,
+      GenKey(pFont, matrix, dest_width, anti_alias, /*bNative=*/false),
+      glyph_index, bFontStyle, dest_width, anti_alias);
 #endif
 }
 
@@ -334,27 +363,17 @@ void CFX_GlyphCache::InitPlatform() {}
 CFX_GlyphBitmap* CFX_GlyphCache::LookUpGlyphBitmap(
     const CFX_Font* pFont,
     const CFX_Matrix& matrix,
-    const ByteString& FaceGlyphsKey,
+    const SizeKey& key,
     uint32_t glyph_index,
     bool bFontStyle,
     int dest_width,
     int anti_alias) {
-  SizeGlyphCache* pSizeCache;
-  auto it = m_SizeMap.find(FaceGlyphsKey);
-  if (it == m_SizeMap.end()) {
-    m_SizeMap[FaceGlyphsKey] = SizeGlyphCache();
-    pSizeCache = &(m_SizeMap[FaceGlyphsKey]);
-  } else {
-    pSizeCache = &(it->second);
-  }
-
-  auto it2 = pSizeCache->find(glyph_index);
-  if (it2 != pSizeCache->end())
-    return it2->second.get();
+  SizeGlyphCache* pSizeCache = GetSizeCache(key);
+  auto it = pSizeCache->glyphs.find(glyph_index);
+  if (it != pSizeCache->glyphs.end())
+    return it->second.get();
 
-  std::unique_ptr<CFX_GlyphBitmap> pGlyphBitmap = RenderGlyph(
-      pFont, glyph_index, bFontStyle, matrix, dest_width, anti_alias);
-  CFX_GlyphBitmap* pResult = pGlyphBitmap.get();
-  (*pSizeCache)[glyph_index] = std::move(pGlyphBitmap);
-  return pResult;
+  return AddGlyphBitmap(pSizeCache, glyph_index,
+                        RenderGlyph(pFont, glyph_index, bFontStyle, matrix,
+                                    dest_width, anti_alias));
 }
@@ -10,6 +10,8 @@
 #include <map>
 #include <memory>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 #include "core/fxcrt/fx_string.h"
 #include "core/fxcrt/observed_ptr.h"
@@ -43,6 +45,17 @@ class CFX_GlyphCache : public Retainable, public Observable {
                                     uint32_t glyph_index,
                                     int dest_width);
 
+  // Returns the bytes held by glyph bitmaps in all glyph caches.
+  static size_t GetTotalBitmapBytes();
+
+  // Appends a <last use, bytes> pair for every size cache of this face.
+  void GetSizeCacheUsage(std::vector<std::pair<uint64_t, size_t>>* usage) const;
+
+  // Drops the glyph bitmaps of every size cache last used before |tick|.
+  // Pointers previously returned by LoadGlyphBitmap() for those sizes become
+  // invalid, so only call this between text runs.
+  void EvictSizeCachesUsedBefore(uint64_t tick);
+
   RetainPtr<CFX_Face> GetFace() { return m_Face; }
   FXFT_FaceRec* GetFaceRec() { return m_Face ? m_Face->GetRec() : nullptr; }
 
@@ -53,7 +66,33 @@ class CFX_GlyphCache : public Retainable, public Observable {
  private:
   explicit CFX_GlyphCache(RetainPtr<CFX_Face> face);
 
-  using SizeGlyphCache = std::map<uint32_t, std::unique_ptr<CFX_GlyphBitmap>>;
+  // Identifies one rendered size of the face: the device matrix quantized to
+  // 1/10000, the requested width, the anti-aliasing mode and the substitute
+  // font parameters that change the glyph shape.
+  struct SizeKey {
+    bool operator<(const SizeKey& that) const;
+
+    int matrix[4];
+    int dest_width;
+    int anti_alias;
+    int weight;
+    int italic_angle;
+    bool vertical;
+    bool has_subst_font;
+    bool native;
+  };
+
+  struct SizeGlyphCache {
+    SizeGlyphCache();
+    SizeGlyphCache(SizeGlyphCache&&);
+    SizeGlyphCache& operator=(SizeGlyphCache&&);
+    ~SizeGlyphCache();
+
+    std::map<uint32_t, std::unique_ptr<CFX_GlyphBitmap>> glyphs;
+    size_t bitmap_bytes = 0;
+    uint64_t last_used = 0;
+  };
+
   // <glyph_index, width, weight, angle, vertical>
   using PathMapKey = std::tuple<uint32_t, int, int, int, bool>;
 
@@ -71,16 +110,26 @@ class CFX_GlyphCache : public Retainable, public Observable {
       int anti_alias);
   CFX_GlyphBitmap* LookUpGlyphBitmap(const CFX_Font* pFont,
                                      const CFX_Matrix& matrix,
-                                     const ByteString& FaceGlyphsKey,
+                                     const SizeKey& key,
                                      uint32_t glyph_index,
                                      bool bFontStyle,
                                      int dest_width,
                                      int anti_alias);
   void InitPlatform();
   void DestroyPlatform();
+  static SizeKey GenKey(const CFX_Font* pFont,
+                        const CFX_Matrix& matrix,
+                        int dest_width,
+                        int anti_alias,
+                        bool bNative);
+
+  SizeGlyphCache* GetSizeCache(const SizeKey& key);
+  CFX_GlyphBitmap* AddGlyphBitmap(SizeGlyphCache* pSizeCache,
+                                  uint32_t glyph_index,
+                                  std::unique_ptr<CFX_GlyphBitmap> pBitmap);
 
   RetainPtr<CFX_Face> const m_Face;
-  std::map<ByteString, SizeGlyphCache> m_SizeMap;
+  std::map<SizeKey, SizeGlyphCache> m_SizeMap;
   std::map<PathMapKey, std::unique_ptr<CFX_PathData>> m_PathMap;
 #if defined(_SKIA_SUPPORT_) || defined(_SKIA_SUPPORT_PATHS_)
   sk_sp<SkTypeface> m_pTypeface;
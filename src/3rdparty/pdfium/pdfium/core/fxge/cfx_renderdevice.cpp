@@ -16,6 +16,7 @@
 #include "core/fxge/cfx_defaultrenderdevice.h"
 #include "core/fxge/cfx_fillrenderoptions.h"
 #include "core/fxge/cfx_font.h"
+#include "core/fxge/cfx_fontcache.h"
 #include "core/fxge/cfx_fontmgr.h"
 #include "core/fxge/cfx_gemodule.h"
 #include "core/fxge/cfx_glyphbitmap.h"
@@ -296,6 +297,36 @@ void DrawNormalTextHelper(const RetainPtr<CFX_DIBitmap>& bitmap,
   }
 }
 
+// Adds the coverage of |pGlyph|, scaled by |alpha|, to the 8bpp |pMask| at
+// (|left|, |top|), using the union rule of CFX_DIBitmap::CompositeMask() into
+// a mask. Overlapping glyphs combine as they would when composited one by
+// one, up to rounding.
+void MergeGlyphCoverage(const RetainPtr<CFX_DIBitmap>& pMask,
+                        const RetainPtr<CFX_DIBitmap>& pGlyph,
+                        int left,
+                        int top,
+                        int alpha) {
+  int width = pGlyph->GetWidth();
+  int height = pGlyph->GetHeight();
+  int src_left = 0;
+  int src_top = 0;
+  if (!pMask->GetOverlapRect(left, top, width, height, pGlyph->GetWidth(),
+                             pGlyph->GetHeight(), src_left, src_top,
+                             nullptr)) {
+    return;
+  }
+
+  for (int row = 0; row < height; ++row) {
+    const uint8_t* src_scan = pGlyph->GetScanline(src_top + row) + src_left;
+    uint8_t* dest_scan = pMask->GetWritableScanline(top + row) + left;
+    for (int col = 0; col < width; ++col) {
+      int src_alpha = alpha * src_scan[col] / 255;
+      int back_alpha = dest_scan[col];
+      dest_scan[col] = back_alpha + src_alpha - back_alpha * src_alpha / 255;
+    }
+  }
+}
+
 bool ShouldDrawDeviceText(const CFX_Font* pFont,
                           const CFX_TextRenderOptions& options) {
 #if defined(OS_APPLE)
@@ -896,6 +927,10 @@ bool CFX_RenderDevice::DrawNormalText(int nChars,
                           path_options);
     }
   }
+  // No glyph bitmaps are held between text runs, so this is the point where
+  // the glyph caches may give memory back.
+  CFX_GEModule::Get()->GetFontCache()->TrimGlyphCaches();
+
   std::vector<TextGlyphPos> glyphs(nChars);
   CFX_Matrix deviceCtm = char2device;
 
@@ -956,6 +991,31 @@ bool CFX_RenderDevice::DrawNormalText(int nChars,
     }
     return SetBitMask(bitmap, bmp_rect.left, bmp_rect.top, fill_color);
   }
+  if (anti_alias == FT_RENDER_MODE_NORMAL) {
+    // Gather the coverage of the whole run, scaled by the fill alpha, into one
+    // mask and composite it onto the device once. Scaling per glyph keeps
+    // overlapping translucent glyphs from blending as a single opaque shape.
+    // 8bpp devices have always had the fill alpha applied again by
+    // SetBitMask(); other devices get an opaque fill color instead.
+    auto mask = pdfium::MakeRetain<CFX_DIBitmap>();
+    if (!mask->Create(pixel_width, pixel_height, FXDIB_8bppMask))
+      return false;
+    mask->Clear(0);
+    int coverage_alpha = FXARGB_A(fill_color);
+    for (const TextGlyphPos& glyph : glyphs) {
+      if (!glyph.m_pGlyph)
+        continue;
+
+      Optional<CFX_Point> point = glyph.GetOrigin({pixel_left, pixel_top});
+      if (!point.has_value())
+        continue;
+
+      MergeGlyphCoverage(mask, glyph.m_pGlyph->GetBitmap(), point.value().x,
+                         point.value().y, coverage_alpha);
+    }
+    uint32_t mask_color = m_bpp == 8 ? fill_color : fill_color | 0xff000000;
+    return SetBitMask(mask, bmp_rect.left, bmp_rect.top, mask_color);
+  }
   auto bitmap = pdfium::MakeRetain<CFX_DIBitmap>();
   if (m_bpp == 8) {
     if (!bitmap->Create(pixel_width, pixel_height, FXDIB_8bppMask))
@@ -974,12 +1034,11 @@ bool CFX_RenderDevice::DrawNormalText(int nChars,
       bitmap->m_pAlphaMask->Clear(0);
   }
   int dest_width = pixel_width;
-  int a = 0;
-  int r = 0;
-  int g = 0;
-  int b = 0;
-  if (anti_alias == FT_RENDER_MODE_LCD)
-    std::tie(a, r, g, b) = ArgbDecode(fill_color);
+  int a;
+  int r;
+  int g;
+  int b;
+  std::tie(a, r, g, b) = ArgbDecode(fill_color);
 
   for (const TextGlyphPos& glyph : glyphs) {
     if (!glyph.m_pGlyph)
@@ -990,17 +1049,8 @@ bool CFX_RenderDevice::DrawNormalText(int nChars,
       continue;
 
     const RetainPtr<CFX_DIBitmap>& pGlyph = glyph.m_pGlyph->GetBitmap();
-    int ncols = pGlyph->GetWidth();
+    int ncols = pGlyph->GetWidth() / 3;
     int nrows = pGlyph->GetHeight();
-    if (anti_alias == FT_RENDER_MODE_NORMAL) {
-      if (!bitmap->CompositeMask(point.value().x, point.value().y, ncols, nrows,
-                                 pGlyph, fill_color, 0, 0, BlendMode::kNormal,
-                                 nullptr, false)) {
-        return false;
-      }
-      continue;
-    }
-    ncols /= 3;
     int x_subpixel = static_cast<int>(glyph.m_fDeviceOrigin.x * 3) % 3;
     int start_col = std::max(point->x, 0);
     FX_SAFE_INT32 end_col_safe = point->x;
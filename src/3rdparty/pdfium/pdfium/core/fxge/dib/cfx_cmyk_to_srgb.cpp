@@ -7,6 +7,7 @@
 #include "core/fxge/dib/cfx_cmyk_to_srgb.h"
 
 #include <algorithm>
+#include <cstring>
 #include <tuple>
 
 #include "core/fxcrt/fx_system.h"
@@ -1722,6 +1723,48 @@ std::tuple<uint8_t, uint8_t, uint8_t> AdobeCMYK_to_sRGB1(uint8_t c,
     return std::make_tuple(fix_r >> 8, fix_g >> 8, fix_b >> 8);
 }
 
+void AdobeCMYK_to_sRGB1_Scanline(uint8_t* dest_scan,
+                                 const uint8_t* src_scan,
+                                 int pixels,
+                                 int dest_Bpp)
+{
+    // Flat fills, text and halftones repeat a handful of CMYK values, so the
+    // most recent conversions are kept in a small direct-mapped cache keyed by
+    // the packed CMYK value. Every slot starts out holding CMYK 0, i.e. white.
+    constexpr int kCacheBits = 6;
+    constexpr int kCacheSize = 1 << kCacheBits;
+    uint32_t cache_cmyk[kCacheSize];
+    uint8_t cache_bgr[kCacheSize][3];
+    uint8_t r;
+    uint8_t g;
+    uint8_t b;
+    std::tie(r, g, b) = AdobeCMYK_to_sRGB1(0, 0, 0, 0);
+    for (int i = 0; i < kCacheSize; ++i) {
+        cache_cmyk[i] = 0;
+        cache_bgr[i][0] = b;
+        cache_bgr[i][1] = g;
+        cache_bgr[i][2] = r;
+    }
+    for (int col = 0; col < pixels; ++col) {
+        uint32_t cmyk;
+        memcpy(&cmyk, src_scan, sizeof(cmyk));
+        const uint32_t slot = (cmyk * 0x9E3779B1u) >> (32 - kCacheBits);
+        if (cache_cmyk[slot] != cmyk) {
+            std::tie(r, g, b) = AdobeCMYK_to_sRGB1(src_scan[0], src_scan[1],
+                                                   src_scan[2], src_scan[3]);
+            cache_cmyk[slot] = cmyk;
+            cache_bgr[slot][0] = b;
+            cache_bgr[slot][1] = g;
+            cache_bgr[slot][2] = r;
+        }
+        dest_scan[0] = cache_bgr[slot][0];
+        dest_scan[1] = cache_bgr[slot][1];
+        dest_scan[2] = cache_bgr[slot][2];
+        src_scan += 4;
+        dest_scan += dest_Bpp;
+    }
+}
+
 std::tuple<float, float, float> AdobeCMYK_to_sRGB(float c,
                                                   float m,
                                                   float y,
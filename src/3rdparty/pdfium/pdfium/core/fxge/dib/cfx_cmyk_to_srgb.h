@@ -23,9 +23,18 @@ std::tuple<uint8_t, uint8_t, uint8_t> AdobeCMYK_to_sRGB1(uint8_t c,
                                                          uint8_t y,
                                                          uint8_t k);
 
+// Converts |pixels| CMYK pixels to BGR, the same as calling
+// AdobeCMYK_to_sRGB1() on each. Consecutive BGR triples are |dest_Bpp| bytes
+// apart; any bytes after the triple are left untouched.
+void AdobeCMYK_to_sRGB1_Scanline(uint8_t* dest_scan,
+                                 const uint8_t* src_scan,
+                                 int pixels,
+                                 int dest_Bpp);
+
 }  // namespace fxge
 
 using fxge::AdobeCMYK_to_sRGB;
 using fxge::AdobeCMYK_to_sRGB1;
+using fxge::AdobeCMYK_to_sRGB1_Scanline;
 
 #endif  // CORE_FXGE_DIB_CFX_CMYK_TO_SRGB_H_
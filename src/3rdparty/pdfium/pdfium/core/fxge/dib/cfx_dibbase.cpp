@@ -49,6 +49,43 @@ void Obtain_Pal(std::pair<uint32_t, uint32_t>* luts,
   }
 }
 
+// Side length, in pixels, of the square blocks SwapXY() copies at a time.
+// Transposing block by block keeps the source and destination rows touched by
+// a block in cache, instead of striding through the whole destination for
+// every source row.
+constexpr int kSwapXYBlockSize = 32;
+
+template <int kBytes>
+void SwapXYByBlocks(const CFX_DIBBase* pSrc,
+                    uint8_t* dest_buf,
+                    int dest_pitch,
+                    bool bXFlip,
+                    bool bYFlip) {
+  const int src_width = pSrc->GetWidth();
+  const int src_height = pSrc->GetHeight();
+  const int dest_step = bYFlip ? -dest_pitch : dest_pitch;
+  for (int row_block = 0; row_block < src_height;
+       row_block += kSwapXYBlockSize) {
+    int row_end = std::min(row_block + kSwapXYBlockSize, src_height);
+    for (int col_block = 0; col_block < src_width;
+         col_block += kSwapXYBlockSize) {
+      int col_end = std::min(col_block + kSwapXYBlockSize, src_width);
+      int dest_row = bYFlip ? src_width - 1 - col_block : col_block;
+      uint8_t* dest_block = dest_buf + dest_row * dest_pitch;
+      for (int row = row_block; row < row_end; ++row) {
+        int dest_col = bXFlip ? src_height - 1 - row : row;
+        const uint8_t* src_scan = pSrc->GetScanline(row) + col_block * kBytes;
+        uint8_t* dest_scan = dest_block + dest_col * kBytes;
+        for (int col = col_block; col < col_end; ++col) {
+          memcpy(dest_scan, src_scan, kBytes);
+          src_scan += kBytes;
+          dest_scan += dest_step;
+        }
+      }
+    }
+  }
+}
+
 class CFX_Palette {
  public:
   explicit CFX_Palette(const RetainPtr<CFX_DIBBase>& pBitmap);
@@ -563,12 +600,7 @@ void ConvertBuffer_32bppCmyk2Rgb32(uint8_t* dest_buf,
     uint8_t* dest_scan = dest_buf + row * dest_pitch;
     const uint8_t* src_scan =
         pSrcBitmap->GetScanline(src_top + row) + src_left * 4;
-    for (int col = 0; col < width; ++col) {
-      std::tie(dest_scan[2], dest_scan[1], dest_scan[0]) = AdobeCMYK_to_sRGB1(
-          src_scan[0], src_scan[1], src_scan[2], src_scan[3]);
-      dest_scan += 4;
-      src_scan += 4;
-    }
+    AdobeCMYK_to_sRGB1_Scanline(dest_scan, src_scan, width, 4);
   }
 }
 
@@ -1126,57 +1158,25 @@ RetainPtr<CFX_DIBitmap> CFX_DIBBase::SwapXY(bool bXFlip, bool bYFlip) const {
       }
     }
   } else {
-    int nBytes = GetBPP() / 8;
-    int dest_step = bYFlip ? -dest_pitch : dest_pitch;
-    if (nBytes == 3)
-      dest_step -= 2;
-    for (int row = row_start; row < row_end; ++row) {
-      int dest_col = (bXFlip ? dest_clip.right - (row - row_start) - 1 : row) -
-                     dest_clip.left;
-      uint8_t* dest_scan = dest_buf + dest_col * nBytes;
-      if (bYFlip)
-        dest_scan += (result_height - 1) * dest_pitch;
-      if (nBytes == 4) {
-        const uint32_t* src_scan =
-            reinterpret_cast<const uint32_t*>(GetScanline(row)) + col_start;
-        for (int col = col_start; col < col_end; ++col) {
-          uint32_t* dest_scan32 = reinterpret_cast<uint32_t*>(dest_scan);
-          *dest_scan32 = *src_scan++;
-          dest_scan += dest_step;
-        }
-      } else {
-        const uint8_t* src_scan = GetScanline(row) + col_start * nBytes;
-        if (nBytes == 1) {
-          for (int col = col_start; col < col_end; ++col) {
-            *dest_scan = *src_scan++;
-            dest_scan += dest_step;
-          }
-        } else {
-          for (int col = col_start; col < col_end; ++col) {
-            memcpy(dest_scan, src_scan, 3);
-            dest_scan += 2 + dest_step;
-            src_scan += 3;
-          }
-        }
-      }
+    switch (GetBPP()) {
+      case 8:
+        SwapXYByBlocks<1>(this, dest_buf, dest_pitch, bXFlip, bYFlip);
+        break;
+      case 24:
+        SwapXYByBlocks<3>(this, dest_buf, dest_pitch, bXFlip, bYFlip);
+        break;
+      case 32:
+        SwapXYByBlocks<4>(this, dest_buf, dest_pitch, bXFlip, bYFlip);
+        break;
+      default:
+        NOTREACHED();
+        break;
     }
   }
   if (m_pAlphaMask) {
-    dest_pitch = pTransBitmap->m_pAlphaMask->GetPitch();
-    dest_buf = pTransBitmap->m_pAlphaMask->GetBuffer();
-    int dest_step = bYFlip ? -dest_pitch : dest_pitch;
-    for (int row = row_start; row < row_end; ++row) {
-      int dest_col = (bXFlip ? dest_clip.right - (row - row_start) - 1 : row) -
-                     dest_clip.left;
-      uint8_t* dest_scan = dest_buf + dest_col;
-      if (bYFlip)
-        dest_scan += (result_height - 1) * dest_pitch;
-      const uint8_t* src_scan = m_pAlphaMask->GetScanline(row) + col_start;
-      for (int col = col_start; col < col_end; ++col) {
-        *dest_scan = *src_scan++;
-        dest_scan += dest_step;
-      }
-    }
+    SwapXYByBlocks<1>(m_pAlphaMask.Get(),
+                      pTransBitmap->m_pAlphaMask->GetBuffer(),
+                      pTransBitmap->m_pAlphaMask->GetPitch(), bXFlip, bYFlip);
   }
   return pTransBitmap;
 }
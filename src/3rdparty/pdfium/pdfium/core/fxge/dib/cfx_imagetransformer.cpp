@@ -154,6 +154,13 @@ void WriteColorResult(const F& func,
   }
 }
 
+// Source position of a destination pixel, in the same fixed point units as
+// CPDF_FixedMatrix. Kept in 64 bits so stepping across a row cannot overflow.
+struct FixedPoint {
+  int64_t x;
+  int64_t y;
+};
+
 class CPDF_FixedMatrix {
  public:
   explicit CPDF_FixedMatrix(const CFX_Matrix& src)
@@ -164,18 +171,26 @@ class CPDF_FixedMatrix {
         e(FXSYS_roundf(src.e * kBase)),
         f(FXSYS_roundf(src.f * kBase)) {}
 
-  void Transform(int x, int y, int* x1, int* y1) const {
-    std::pair<float, float> val = TransformInternal(x, y);
-    *x1 = pdfium::base::saturated_cast<int>(val.first / kBase);
-    *y1 = pdfium::base::saturated_cast<int>(val.second / kBase);
+  // Returns the position of destination pixel (0, |y|). Callers walk a row
+  // with Step() instead of transforming every pixel from scratch. Positions
+  // are exact integers. The float transform this replaced rounded once a
+  // value reached 2^24, so far from the origin the chosen source pixel or
+  // bilinear weight can differ slightly from older output.
+  FixedPoint RowOrigin(int y) const {
+    return {int64_t{c} * y + e + kBase / 2, int64_t{d} * y + f + kBase / 2};
   }
 
- protected:
-  std::pair<float, float> TransformInternal(float x, float y) const {
-    return std::make_pair(a * x + c * y + e + kBase / 2,
-                          b * x + d * y + f + kBase / 2);
+  void Step(FixedPoint* pt) const {
+    pt->x += a;
+    pt->y += b;
   }
 
+  static void Resolve(const FixedPoint& pt, int* x1, int* y1) {
+    *x1 = pdfium::base::saturated_cast<int>(pt.x / kBase);
+    *y1 = pdfium::base::saturated_cast<int>(pt.y / kBase);
+  }
+
+ protected:
   const int a;
   const int b;
   const int c;
@@ -188,13 +203,15 @@ class CFX_BilinearMatrix final : public CPDF_FixedMatrix {
  public:
   explicit CFX_BilinearMatrix(const CFX_Matrix& src) : CPDF_FixedMatrix(src) {}
 
-  void Transform(int x, int y, int* x1, int* y1, int* res_x, int* res_y) const {
-    std::pair<float, float> val = TransformInternal(x, y);
-    *x1 = pdfium::base::saturated_cast<int>(val.first / kBase);
-    *y1 = pdfium::base::saturated_cast<int>(val.second / kBase);
+  static void Resolve(const FixedPoint& pt,
+                      int* x1,
+                      int* y1,
+                      int* res_x,
+                      int* res_y) {
+    CPDF_FixedMatrix::Resolve(pt, x1, y1);
 
-    *res_x = static_cast<int>(val.first) % kBase;
-    *res_y = static_cast<int>(val.second) % kBase;
+    *res_x = static_cast<int>(pt.x % kBase);
+    *res_y = static_cast<int>(pt.y % kBase);
     if (*res_x < 0 && *res_x > -kBase)
       *res_x = kBase + *res_x;
     if (*res_y < 0 && *res_y > -kBase)
@@ -227,14 +244,12 @@ void DoBilinearLoop(const CFX_ImageTransformer::CalcData& cdata,
   CFX_BilinearMatrix matrix_fix(cdata.matrix);
   for (int row = 0; row < result_rect.Height(); row++) {
     uint8_t* dest = cdata.bitmap->GetWritableScanline(row);
+    FixedPoint pos = matrix_fix.RowOrigin(row);
     for (int col = 0; col < result_rect.Width(); col++) {
       CFX_ImageTransformer::BilinearData d;
-      d.res_x = 0;
-      d.res_y = 0;
-      d.src_col_l = 0;
-      d.src_row_l = 0;
-      matrix_fix.Transform(col, row, &d.src_col_l, &d.src_row_l, &d.res_x,
-                           &d.res_y);
+      CFX_BilinearMatrix::Resolve(pos, &d.src_col_l, &d.src_row_l, &d.res_x,
+                                  &d.res_y);
+      matrix_fix.Step(&pos);
       if (LIKELY(InStretchBounds(clip_rect, d.src_col_l, d.src_row_l))) {
         AdjustCoords(clip_rect, &d.src_col_l, &d.src_row_l);
         d.src_col_r = d.src_col_l + 1;
@@ -260,14 +275,12 @@ void DoBicubicLoop(const CFX_ImageTransformer::CalcData& cdata,
   CFX_BilinearMatrix matrix_fix(cdata.matrix);
   for (int row = 0; row < result_rect.Height(); row++) {
     uint8_t* dest = cdata.bitmap->GetWritableScanline(row);
+    FixedPoint pos = matrix_fix.RowOrigin(row);
     for (int col = 0; col < result_rect.Width(); col++) {
       CFX_ImageTransformer::BicubicData d;
-      d.res_x = 0;
-      d.res_y = 0;
-      d.src_col_l = 0;
-      d.src_row_l = 0;
-      matrix_fix.Transform(col, row, &d.src_col_l, &d.src_row_l, &d.res_x,
-                           &d.res_y);
+      CFX_BilinearMatrix::Resolve(pos, &d.src_col_l, &d.src_row_l, &d.res_x,
+                                  &d.res_y);
+      matrix_fix.Step(&pos);
       if (LIKELY(InStretchBounds(clip_rect, d.src_col_l, d.src_row_l))) {
         AdjustCoords(clip_rect, &d.src_col_l, &d.src_row_l);
         bicubic_get_pos_weight(d.pos_pixel, d.u_w, d.v_w, d.src_col_l,
@@ -291,11 +304,11 @@ void DoDownSampleLoop(const CFX_ImageTransformer::CalcData& cdata,
   CPDF_FixedMatrix matrix_fix(cdata.matrix);
   for (int row = 0; row < result_rect.Height(); row++) {
     uint8_t* dest = cdata.bitmap->GetWritableScanline(row);
+    FixedPoint pos = matrix_fix.RowOrigin(row);
     for (int col = 0; col < result_rect.Width(); col++) {
       CFX_ImageTransformer::DownSampleData d;
-      d.src_col = 0;
-      d.src_row = 0;
-      matrix_fix.Transform(col, row, &d.src_col, &d.src_row);
+      CPDF_FixedMatrix::Resolve(pos, &d.src_col, &d.src_row);
+      matrix_fix.Step(&pos);
       if (LIKELY(InStretchBounds(clip_rect, d.src_col, d.src_row))) {
         AdjustCoords(clip_rect, &d.src_col, &d.src_row);
         func(d, dest);
@@ -4,6 +4,10 @@
 
 // Original code copyright 2014 Foxit Software Inc. http://www.foxitsoftware.com
 
+#include <errno.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+
 #include <memory>
 #include <utility>
 
@@ -53,6 +57,27 @@ const char* const g_LinuxHGFontList[] = {
     "UnDotum",
 };
 
+// Returns where the font folder scan results are kept between runs, following
+// the XDG base directory layout, or an empty string when there is no usable
+// cache directory.
+ByteString GetFontScanCachePath() {
+  ByteString path;
+  const char* cache_home = getenv("XDG_CACHE_HOME");
+  if (cache_home && cache_home[0] == '/') {
+    path = cache_home;
+  } else {
+    const char* home = getenv("HOME");
+    if (!home || home[0] != '/')
+      return ByteString();
+    path = ByteString(home) + "/.cache";
+  }
+  mkdir(path.c_str(), 0700);
+  path += "/deepin-pdfium";
+  if (mkdir(path.c_str(), 0700) != 0 && errno != EEXIST)
+    return ByteString();
+  return path + "/fontscan.cache";
+}
+
 uint8_t GetJapanesePreference(const char* facearr,
                               int weight,
                               int pitch_family) {
@@ -170,6 +195,7 @@ class CLinuxPlatform : public CFX_GEModule::PlatformIface {
       pInfo->AddPath("/usr/share/X11/fonts/TTF");
       pInfo->AddPath("/usr/local/share/fonts");
     }
+    pInfo->SetScanCachePath(GetFontScanCachePath());
     return pInfo;
   }
 };
@@ -40,6 +40,7 @@ void RenderPageImpl(CPDF_PageRenderContext *pContext,
     options.bNoTextSmooth = !!(flags & FPDF_RENDER_NO_SMOOTHTEXT);
     options.bNoImageSmooth = !!(flags & FPDF_RENDER_NO_SMOOTHIMAGE);
     options.bNoPathSmooth = !!(flags & FPDF_RENDER_NO_SMOOTHPATH);
+    options.bSimplifyPaths = !!(flags & FPDF_RENDER_SIMPLIFY_PATH);
 
     // Grayscale output
     if (flags & FPDF_GRAYSCALE)
@@ -32,6 +32,7 @@
 #include "core/fpdfapi/render/cpdf_renderoptions.h"
 #include "core/fpdfdoc/cpdf_nametree.h"
 #include "core/fpdfdoc/cpdf_viewerpreferences.h"
+#include "core/fxcodec/jbig2/JBig2_DocumentContext.h"
 #include "core/fxcrt/cfx_readonlymemorystream.h"
 #include "core/fxcrt/fx_safe_types.h"
 #include "core/fxcrt/fx_stream.h"
@@ -374,6 +375,44 @@ FPDF_GetSecurityHandlerRevision(FPDF_DOCUMENT document)
     return pDict ? pDict->GetIntegerFor("R") : -1;
 }
 
+FPDF_EXPORT void FPDF_CALLCONV
+FPDF_SetJBIG2SymbolDictCacheSize(FPDF_DOCUMENT document, unsigned long bytes)
+{
+    CPDF_Document *pDoc = CPDFDocumentFromFPDFDocument(document);
+    if (!pDoc)
+        return;
+
+    std::unique_ptr<JBig2_DocumentContext> *pHolder = pDoc->CodecContext();
+    if (!*pHolder)
+        *pHolder = std::make_unique<JBig2_DocumentContext>();
+    (*pHolder)->SetSymbolDictCacheBudget(bytes);
+}
+
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_GetJBIG2SymbolDictCacheStats(FPDF_DOCUMENT document,
+                                  unsigned long *hits,
+                                  unsigned long *misses,
+                                  unsigned long *entries,
+                                  unsigned long *bytes)
+{
+    CPDF_Document *pDoc = CPDFDocumentFromFPDFDocument(document);
+    if (!pDoc)
+        return false;
+
+    JBig2_DocumentContext::SymbolDictCacheStats stats;
+    if (*pDoc->CodecContext())
+        stats = (*pDoc->CodecContext())->GetSymbolDictCacheStats();
+    if (hits)
+        *hits = stats.hits;
+    if (misses)
+        *misses = stats.misses;
+    if (entries)
+        *entries = stats.entries;
+    if (bytes)
+        *bytes = stats.bytes;
+    return true;
+}
+
 FPDF_EXPORT int FPDF_CALLCONV FPDF_GetPageCount(FPDF_DOCUMENT document)
 {
     auto *pDoc = CPDFDocumentFromFPDFDocument(document);
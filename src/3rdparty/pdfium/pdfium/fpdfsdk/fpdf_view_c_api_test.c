@@ -435,6 +435,7 @@ int CheckPDFiumCApi() {
 #endif
     CHK(FPDF_GetDocPermissions);
     CHK(FPDF_GetFileVersion);
+    CHK(FPDF_GetJBIG2SymbolDictCacheStats);
     CHK(FPDF_GetLastError);
     CHK(FPDF_GetNamedDest);
     CHK(FPDF_GetNamedDestByName);
@@ -476,6 +477,7 @@ int CheckPDFiumCApi() {
     CHK(FPDF_SetPrintTextWithGDI);
 #endif
 #endif
+    CHK(FPDF_SetJBIG2SymbolDictCacheSize);
     CHK(FPDF_SetSandBoxPolicy);
 #if defined(_WIN32) && defined(PDFIUM_PRINT_TEXT_WITH_GDI)
     CHK(FPDF_SetTypefaceAccessibleFunc);
@@ -649,6 +649,45 @@ FPDF_GetDocPermissions(FPDF_DOCUMENT document);
 FPDF_EXPORT int FPDF_CALLCONV
 FPDF_GetSecurityHandlerRevision(FPDF_DOCUMENT document);
 
+// Function: FPDF_SetJBIG2SymbolDictCacheSize
+//          Set how many bytes of decoded JBIG2 global symbol dictionaries the
+//          document keeps between images.
+// Parameters:
+//          document    -   Handle to a document. Returned by FPDF_LoadDocument.
+//          bytes       -   Cache budget in bytes. 0 disables the cache.
+// Return value:
+//          None.
+// Comments:
+//          Scanned documents usually share one or a few JBIG2Globals symbol
+//          dictionaries across all pages; while they stay cached, later pages
+//          skip symbol decoding. The most recently used dictionary is kept
+//          even when it alone exceeds a non-zero budget. The default budget is
+//          16 MB.
+FPDF_EXPORT void FPDF_CALLCONV
+FPDF_SetJBIG2SymbolDictCacheSize(FPDF_DOCUMENT document, unsigned long bytes);
+
+// Function: FPDF_GetJBIG2SymbolDictCacheStats
+//          Get usage statistics of the document's JBIG2 symbol dictionary
+//          cache.
+// Parameters:
+//          document    -   Handle to a document. Returned by FPDF_LoadDocument.
+//          hits        -   Receives the number of dictionaries served from
+//                          the cache. May be NULL.
+//          misses      -   Receives the number of dictionaries that had to be
+//                          decoded. May be NULL.
+//          entries     -   Receives the number of cached dictionaries. May be
+//                          NULL.
+//          bytes       -   Receives the approximate size of the cached
+//                          dictionaries in bytes. May be NULL.
+// Return value:
+//          TRUE on success, FALSE if |document| is invalid.
+FPDF_EXPORT FPDF_BOOL FPDF_CALLCONV
+FPDF_GetJBIG2SymbolDictCacheStats(FPDF_DOCUMENT document,
+                                  unsigned long* hits,
+                                  unsigned long* misses,
+                                  unsigned long* entries,
+                                  unsigned long* bytes);
+
 // Function: FPDF_GetPageCount
 //          Get total number of pages in the document.
 // Parameters:
@@ -792,6 +831,10 @@ FPDF_EXPORT int FPDF_CALLCONV FPDF_GetPageSizeByIndex(FPDF_DOCUMENT document,
 #define FPDF_RENDER_NO_SMOOTHIMAGE 0x2000
 // Set to disable anti-aliasing on paths.
 #define FPDF_RENDER_NO_SMOOTHPATH 0x4000
+// Set to skip paths smaller than half a device pixel and to drop path
+// vertices that do not visibly change the outline at the rendered scale.
+// Speeds up zoomed-out views of maps and drawings; output is approximate.
+#define FPDF_RENDER_SIMPLIFY_PATH 0x8000
 // Set whether to render in a reverse Byte order, this flag is only used when
 // rendering to a bitmap.
 #define FPDF_REVERSE_BYTE_ORDER 0x10
@@ -50,6 +50,11 @@ path_storage::path_storage() :
     m_iterator(0)
 {
 }
+void path_storage::remove_all()
+{
+    m_total_vertices = 0;
+    m_iterator = 0;
+}
 void path_storage::allocate_block(unsigned nb)
 {
     if(nb >= m_max_blocks) {
@@ -48,6 +48,7 @@ public:
     };
     ~path_storage();
     path_storage();
+    void remove_all();
     unsigned last_vertex(float* x, float* y) const;
     unsigned prev_vertex(float* x, float* y) const;
     void move_to(float x, float y);